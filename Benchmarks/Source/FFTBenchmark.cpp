@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    FFTBenchmark.cpp
+    Created: 19 Oct 2026 2:31:45pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#include "FFTBenchmark.h"
+#include "../../Source/DSP/FFTBackend.h"
+#include "../../Source/GUI/Utils.h"
+
+juce::String runFFTBenchmark(int numIterations)
+{
+    juce::String report;
+    report << "FFT benchmark, " << numIterations << " transforms per run" << juce::newLine;
+    
+    juce::Random random;
+    
+    for( auto order : { FFTOrder::order2048, FFTOrder::order4096, FFTOrder::order8192, FFTOrder::order16384 } )
+    {
+        const auto fftSize = 1 << order;
+        
+        std::vector<float> input(static_cast<size_t>(fftSize));
+        for( auto& sample : input )
+            sample = random.nextFloat() * 2.f - 1.f;
+        
+        // times one backend and leaves its last result in data
+        auto timeBackend = [&input, fftSize, numIterations](FFTBackend& fft, std::vector<float>& data)
+        {
+            data.assign(static_cast<size_t>(fftSize * 2), 0.f);
+            
+            const auto start = juce::Time::getHighResolutionTicks();
+            for( int i = 0; i < numIterations; ++i )
+            {
+                std::copy(input.begin(), input.end(), data.begin());
+                fft.performFrequencyOnlyForwardTransform(data.data());
+            }
+            const auto end = juce::Time::getHighResolutionTicks();
+            
+            return juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6 / double(numIterations);
+        };
+        
+        auto bundled = FFTBackend::create(order, FFTBackend::Type::Bundled);
+        auto reference = FFTBackend::create(order, FFTBackend::Type::Juce);
+        
+        std::vector<float> bundledData, referenceData;
+        const auto bundledMicros = timeBackend(*bundled, bundledData);
+        const auto referenceMicros = timeBackend(*reference, referenceData);
+        
+        float maxError = 0.f;
+        for( int bin = 0; bin <= fftSize / 2; ++bin )
+            maxError = juce::jmax(maxError, std::abs(bundledData[static_cast<size_t>(bin)] - referenceData[static_cast<size_t>(bin)]));
+        
+        report << fftSize << ": "
+               << bundled->getName() << " " << juce::String(bundledMicros, 2) << "us, "
+               << reference->getName() << " " << juce::String(referenceMicros, 2) << "us, "
+               << "speedup " << juce::String(referenceMicros / juce::jmax(bundledMicros, 1.0e-9), 2) << "x, "
+               << "max difference " << juce::String(maxError, 6) << juce::newLine;
+    }
+    
+    return report;
+}
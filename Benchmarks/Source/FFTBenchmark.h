@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    FFTBenchmark.h
+    Created: 19 Oct 2026 2:31:45pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @brief Times the bundled RealFFT backend against juce::dsp::FFT for orders 2048 to 16384.
+ Each backend runs performFrequencyOnlyForwardTransform on the same noise numIterations times per order (the
+ input copy is included, like the analyzer does it). The report lists the microseconds per transform, the
+ speedup of the bundled backend and the largest magnitude difference between the two, so a faster but wrong
+ kernel shows up too.
+ @param numIterations How many transforms to time per backend and order.
+ @return A multi line report.
+ */
+juce::String runFFTBenchmark(int numIterations = 2000);
@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 10:41:18pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FFTBenchmark.h"
+#include "StateBenchmark.h"
+
+/*!
+ @brief Runs every benchmark and prints the reports. They live in this console app, not in the plugin, so
+ nothing in here ever runs inside a host.
+ */
+int main (int argc, char* argv[])
+{
+    // the AudioProcessorValueTreeState of the state benchmark needs a message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    std::cout << runFFTBenchmark() << std::endl;
+    std::cout << runStateBenchmark() << std::endl;
+    
+    return 0;
+}
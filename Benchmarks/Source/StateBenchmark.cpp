@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    StateBenchmark.cpp
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#include "StateBenchmark.h"
+#include "../../Source/DSP/BinaryState.h"
+#include "../../Source/DSP/Params.h"
+
+namespace
+{
+    /*! just enough of a processor to own the plugin's parameters */
+    struct ParameterHost : juce::AudioProcessor
+    {
+        juce::AudioProcessorValueTreeState apvts { *this, nullptr, "Parameters", Params::createParameterLayout() };
+        
+        const juce::String getName() const override { return "ParameterHost"; }
+        void prepareToPlay(double, int) override {}
+        void releaseResources() override {}
+        void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+        double getTailLengthSeconds() const override { return 0.0; }
+        bool acceptsMidi() const override { return false; }
+        bool producesMidi() const override { return false; }
+        juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+        bool hasEditor() const override { return false; }
+        int getNumPrograms() override { return 1; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram(int) override {}
+        const juce::String getProgramName(int) override { return {}; }
+        void changeProgramName(int, const juce::String&) override {}
+        
+        void getStateInformation(juce::MemoryBlock& destData) override { BinaryState::write(apvts, destData); }
+        
+        // as the plugin restores either format
+        void setStateInformation(const void* data, int sizeInBytes) override
+        {
+            if( BinaryState::isBinaryState(data, sizeInBytes) )
+            {
+                BinaryState::read(apvts, data, sizeInBytes);
+                return;
+            }
+            
+            auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+            if( tree.isValid() )
+                apvts.replaceState(tree);
+        }
+    };
+}
+
+juce::String runStateBenchmark(int numInstances)
+{
+    ParameterHost processor;
+    auto& apvts = processor.apvts;
+    
+    juce::Random random;
+    auto randomise = [&apvts, &random]()
+    {
+        for( size_t i = 0; i < Params::NumParams; ++i )
+            Params::get(apvts, static_cast<Params::Names>(i)).setValueNotifyingHost(random.nextFloat());
+    };
+    
+    auto saveValueTree = [&apvts](juce::MemoryBlock& destData)
+    {
+        juce::MemoryOutputStream mos(destData, true);
+        apvts.copyState().writeToStream(mos);
+    };
+    
+    // the two states every restore alternates between, in both formats
+    std::array<juce::MemoryBlock, 2> binaryStates, valueTreeStates;
+    for( size_t i = 0; i < 2; ++i )
+    {
+        randomise();
+        BinaryState::write(apvts, binaryStates[i]);
+        saveValueTree(valueTreeStates[i]);
+    }
+    
+    auto timePerInstance = [numInstances](auto&& run)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        for( int i = 0; i < numInstances; ++i )
+            run(static_cast<size_t>(i & 1));
+        const auto end = juce::Time::getHighResolutionTicks();
+        
+        return juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6 / double(numInstances);
+    };
+    
+    juce::MemoryBlock scratch;
+    const auto binarySaveMicros = timePerInstance([&](size_t) { scratch.reset(); BinaryState::write(apvts, scratch); });
+    const auto valueTreeSaveMicros = timePerInstance([&](size_t) { scratch.reset(); saveValueTree(scratch); });
+    
+    const auto binaryRestoreMicros = timePerInstance([&](size_t i)
+    {
+        processor.setStateInformation(binaryStates[i].getData(), static_cast<int>(binaryStates[i].getSize()));
+    });
+    // setStateInformation() takes the ValueTree fallback for these, like it does for an old session
+    const auto valueTreeRestoreMicros = timePerInstance([&](size_t i)
+    {
+        processor.setStateInformation(valueTreeStates[i].getData(), static_cast<int>(valueTreeStates[i].getSize()));
+    });
+    
+    // a restored binary state has to write back out byte for byte
+    processor.setStateInformation(binaryStates[0].getData(), static_cast<int>(binaryStates[0].getSize()));
+    scratch.reset();
+    BinaryState::write(apvts, scratch);
+    const auto roundTripExact = scratch == binaryStates[0];
+    
+    auto speedup = [](double reference, double micros) { return juce::String(reference / juce::jmax(micros, 1.0e-9), 2); };
+    
+    juce::String report;
+    report << "State benchmark, " << numInstances << " instances" << juce::newLine
+           << "save: binary " << juce::String(binarySaveMicros, 2) << "us, "
+           << "ValueTree " << juce::String(valueTreeSaveMicros, 2) << "us, "
+           << "speedup " << speedup(valueTreeSaveMicros, binarySaveMicros) << "x" << juce::newLine
+           << "restore: binary " << juce::String(binaryRestoreMicros, 2) << "us, "
+           << "ValueTree " << juce::String(valueTreeRestoreMicros, 2) << "us, "
+           << "speedup " << speedup(valueTreeRestoreMicros, binaryRestoreMicros) << "x" << juce::newLine
+           << "size: binary " << (int) binaryStates[0].getSize() << " bytes, "
+           << "ValueTree " << (int) valueTreeStates[0].getSize() << " bytes" << juce::newLine
+           << "binary round trip " << (roundTripExact ? "exact" : "NOT EXACT") << juce::newLine;
+    
+    return report;
+}
@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+
+    StateBenchmark.h
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @brief Times saving and restoring the plugin's state as a BinaryState against the ValueTree path older
+ versions used, the way a host opening or saving a session with numInstances instances would.
+ The parameters are the plugin's, built from Params::createParameterLayout() on a processor of the benchmark's
+ own, and restoring does what SimpleMBCompAudioProcessor::setStateInformation() does for either format.
+ Two randomised states are saved and restored alternately, so every restore changes every parameter. The
+ report lists the microseconds per instance and the bytes per state of both formats, and whether the binary
+ round trip reproduced every parameter exactly.
+ @param numInstances How many saves and restores to time per format.
+ @return A multi line report.
+ */
+juce::String runStateBenchmark(int numInstances = 300);
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    BinaryState.cpp
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#include "BinaryState.h"
+#include "Params.h"
+
+void BinaryState::write(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData)
+{
+    using namespace Params;
+
+    juce::MemoryOutputStream mos(destData, true);
+    mos.preallocate(destData.getSize() + headerSize + NumParams * sizeof(float));
+
+    mos.writeInt(magic);
+    mos.writeShort(static_cast<short>(currentVersion));
+    mos.writeShort(static_cast<short>(NumParams));
+
+    // plain values rather than normalised ones, so a state survives a parameter's range changing
+    for( size_t i = 0; i < NumParams; ++i )
+    {
+        const auto& param = get(apvts, static_cast<Names>(i));
+        mos.writeFloat(param.convertFrom0to1(param.getValue()));
+    }
+}
+
+bool BinaryState::isBinaryState(const void* data, int sizeInBytes)
+{
+    if( data == nullptr || sizeInBytes < headerSize )
+        return false;
+
+    return static_cast<juce::int32>(juce::ByteOrder::littleEndianInt(data)) == magic;
+}
+
+bool BinaryState::read(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes)
+{
+    using namespace Params;
+
+    if( ! isBinaryState(data, sizeInBytes) )
+        return false;
+
+    juce::MemoryInputStream mis(data, static_cast<size_t>(sizeInBytes), false);
+    mis.readInt();
+
+    const auto version = static_cast<int>(static_cast<juce::uint16>(mis.readShort()));
+    const auto numStored = static_cast<size_t>(static_cast<juce::uint16>(mis.readShort()));
+
+    // a newer version may have changed the layout, so don't guess at it
+    if( version < 1 || version > currentVersion
+        || sizeInBytes < headerSize + static_cast<int>(numStored * sizeof(float)) )
+        return false;
+
+    // validate and convert everything before a single parameter is touched
+    std::array<float, NumParams> values;
+    for( size_t i = 0; i < NumParams; ++i )
+        values[i] = get(apvts, static_cast<Names>(i)).getDefaultValue();
+
+    for( size_t i = 0; i < numStored; ++i )
+    {
+        const auto plain = mis.readFloat();
+
+        // a NaN or inf would go straight through convertTo0to1() and into the DSP, so the whole state is corrupt
+        if( ! std::isfinite(plain) )
+            return false;
+
+        if( i < NumParams )
+            values[i] = get(apvts, static_cast<Names>(i)).convertTo0to1(plain);
+    }
+
+    // write directly, without notifying anybody yet
+    std::array<bool, NumParams> changed {};
+    for( size_t i = 0; i < NumParams; ++i )
+    {
+        auto& param = get(apvts, static_cast<Names>(i));
+        if( param.getValue() != values[i] )
+        {
+            param.setValue(values[i]);
+            changed[i] = true;
+        }
+    }
+
+    // one notification per changed parameter, the APVTS tree and any attachments pick it up from here
+    for( size_t i = 0; i < NumParams; ++i )
+    {
+        if( changed[i] )
+        {
+            auto& param = get(apvts, static_cast<Names>(i));
+            param.sendValueChangedMessageToListeners(param.getValue());
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    BinaryState.h
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class BinaryState
+ @brief A compact, versioned binary form of the plugin state, for hosts that save and open many instances.
+ The layout is a 4 byte magic number, a 16 bit version, a 16 bit parameter count and then every parameter's
+ plain value as a 32 bit float, in Params::Names order, all little endian. Names is append-only, so a state with
+ fewer values than this build has parameters leaves the newer ones at their defaults, and one with more just
+ has its extra values ignored.
+ read() writes the parameter values directly and only notifies listeners and the host once the whole state is
+ in place, and only for parameters whose value actually changed. apvts.replaceState() instead rebuilds the tree
+ and pushes every parameter through setValueNotifyingHost() one by one.
+ States saved as a ValueTree by older versions are not BinaryStates, isBinaryState() tells them apart.
+ */
+struct BinaryState
+{
+    static constexpr juce::int32 magic = 0x43424d53; // "SMBC"
+    static constexpr int currentVersion = 1;
+    /*! magic, version and parameter count */
+    static constexpr int headerSize = 8;
+
+    /*!
+     @brief Writes the current parameter values.
+     @param destData Appended to, like getStateInformation() does it.
+     */
+    static void write(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData);
+
+    /*! @return true if the data starts with a BinaryState header. */
+    static bool isBinaryState(const void* data, int sizeInBytes);
+
+    /*!
+     @brief Restores the parameter values from data written by write().
+     @return false, with no parameter touched, if the data isn't a complete BinaryState, was written by a newer
+     version or holds a value that isn't finite.
+     */
+    static bool read(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes);
+};
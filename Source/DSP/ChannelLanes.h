@@ -0,0 +1,79 @@
+/*
+ ==============================================================================
+
+ ChannelLanes.h
+ Created: 19 Oct 2026 10:24:51pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class ChannelLanes
+ @brief Packs the channels of a buffer into SIMD registers, one channel per lane, so the recursive filters can
+ run every channel at once.
+ Channel c goes to lane c % Lanes of group c / Lanes, a 12 channel buffer is three groups with SSE or NEON and
+ two with AVX. A packed buffer holds numGroups * numSamples registers, group after group. Lanes without a channel
+ are zero.
+ */
+struct ChannelLanes
+{
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int Lanes = static_cast<int>(Vec::SIMDNumElements);
+
+    /*! the widest layout the processor accepts, 9.1.6 */
+    static constexpr int MaxChannels = 16;
+
+    static constexpr int numGroups(int numChannels) { return (numChannels + Lanes - 1) / Lanes; }
+
+    /*!
+     @brief Interleaves numSamples samples from startSample on of every channel into dest.
+     */
+    static void pack(const float* const* channels, int numChannels, int startSample, int numSamples, Vec* dest)
+    {
+        for( int group = 0; group < numGroups(numChannels); ++group )
+        {
+            auto* raw = toRaw(dest + group * numSamples);
+            for( int lane = 0; lane < Lanes; ++lane )
+            {
+                const auto channel = group * Lanes + lane;
+                if( channel < numChannels )
+                {
+                    const auto* source = channels[channel] + startSample;
+                    for( int i = 0; i < numSamples; ++i )
+                        raw[i * Lanes + lane] = source[i];
+                }
+                else
+                {
+                    for( int i = 0; i < numSamples; ++i )
+                        raw[i * Lanes + lane] = 0.f;
+                }
+            }
+        }
+    }
+
+    /*!
+     @brief The reverse of pack(), the empty lanes are dropped.
+     */
+    static void unpack(const Vec* source, int numChannels, int startSample, int numSamples, float* const* channels)
+    {
+        for( int group = 0; group < numGroups(numChannels); ++group )
+        {
+            const auto* raw = toRaw(source + group * numSamples);
+            for( int lane = 0; lane < Lanes && group * Lanes + lane < numChannels; ++lane )
+            {
+                auto* dest = channels[group * Lanes + lane] + startSample;
+                for( int i = 0; i < numSamples; ++i )
+                    dest[i] = raw[i * Lanes + lane];
+            }
+        }
+    }
+private:
+    static_assert( sizeof(Vec) == sizeof(float) * Vec::SIMDNumElements, "a register has to be exactly its lanes" );
+
+    static float* toRaw(Vec* v) { return reinterpret_cast<float*>(v); }
+    static const float* toRaw(const Vec* v) { return reinterpret_cast<const float*>(v); }
+};
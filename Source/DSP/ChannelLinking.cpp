@@ -0,0 +1,69 @@
+/*
+ ==============================================================================
+
+ ChannelLinking.cpp
+ Created: 19 Oct 2026 10:24:51pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "ChannelLinking.h"
+
+ChannelGroups ChannelGroups::make(const juce::AudioChannelSet& layout, int numChannels, ChannelLink link)
+{
+    using CT = juce::AudioChannelSet::ChannelType;
+
+    ChannelGroups groups;
+    numChannels = juce::jmin(numChannels, ChannelLanes::MaxChannels);
+
+    if( link == ChannelLink::All )
+    {
+        groups.numGroups = numChannels > 0 ? 1 : 0;
+        return groups;
+    }
+
+    for( int channel = 0; channel < numChannels; ++channel )
+        groups.groupOf[static_cast<size_t>(channel)] = channel;
+
+    if( link == ChannelLink::Pairs )
+    {
+        static constexpr std::array<std::pair<CT, CT>, 9> pairs
+        {{
+            { CT::left, CT::right },
+            { CT::leftCentre, CT::rightCentre },
+            { CT::leftSurround, CT::rightSurround },
+            { CT::leftSurroundSide, CT::rightSurroundSide },
+            { CT::leftSurroundRear, CT::rightSurroundRear },
+            { CT::wideLeft, CT::wideRight },
+            { CT::topFrontLeft, CT::topFrontRight },
+            { CT::topSideLeft, CT::topSideRight },
+            { CT::topRearLeft, CT::topRearRight },
+        }};
+
+        // the right channel joins the left one's group
+        for( const auto& [leftType, rightType] : pairs )
+        {
+            const auto left = layout.getChannelIndexForType(leftType);
+            const auto right = layout.getChannelIndexForType(rightType);
+
+            if( juce::isPositiveAndBelow(left, numChannels) && juce::isPositiveAndBelow(right, numChannels) )
+                groups.groupOf[static_cast<size_t>(right)] = groups.groupOf[static_cast<size_t>(left)];
+        }
+    }
+
+    // renumber without gaps, in channel order
+    std::array<int, ChannelLanes::MaxChannels> renumbered;
+    renumbered.fill(-1);
+    for( int channel = 0; channel < numChannels; ++channel )
+    {
+        auto& group = groups.groupOf[static_cast<size_t>(channel)];
+        auto& number = renumbered[static_cast<size_t>(group)];
+        if( number < 0 )
+            number = groups.numGroups++;
+
+        group = number;
+    }
+
+    return groups;
+}
@@ -0,0 +1,41 @@
+/*
+ ==============================================================================
+
+ ChannelLinking.h
+ Created: 19 Oct 2026 10:24:51pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "ChannelLanes.h"
+
+/*!
+ @brief How the compressors share their detectors between channels, the values of the Channel Link parameter.
+ */
+enum class ChannelLink
+{
+    Off,    //!< every channel is detected on its own
+    Pairs,  //!< the left and right channel of every pair in the layout share a detector (L/R, Ls/Rs, Ltf/Rtf, ...)
+    All     //!< one detector for all channels
+};
+
+/*!
+ @class ChannelGroups
+ @brief Which channels share a detector. Channels of one group are compressed by the same gain, taken from the
+ loudest of them, so a linked pair keeps its image.
+ */
+struct ChannelGroups
+{
+    /*! the group of every channel, groups are numbered from 0 without gaps */
+    std::array<int, ChannelLanes::MaxChannels> groupOf {};
+    int numGroups { 0 };
+
+    /*!
+     @brief The groups for a layout. Channels the layout doesn't name, e.g. discrete ones, stay on their own
+     with ChannelLink::Pairs.
+     */
+    static ChannelGroups make(const juce::AudioChannelSet& layout, int numChannels, ChannelLink link);
+};
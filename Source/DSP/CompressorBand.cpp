@@ -16,43 +16,218 @@
 */
 void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
 {
-    compressor.prepare(spec);
+    sampleRate = spec.sampleRate;
+    
+    const auto numChannels = static_cast<int>(spec.numChannels);
+    const auto maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+    envelopes.assign(static_cast<size_t>(ChannelLanes::numGroups(numChannels)), Vec::expand(0.f));
+    packedDetectors.resize(envelopes.size() * static_cast<size_t>(maxBlockSize));
+    detectorRows.setSize(juce::jmax(1, numChannels), maxBlockSize);
+    
+    updateCompressorSettings(settings);
+    
+    wet.reset(sampleRate, bypassRampSeconds);
+    wet.setCurrentAndTargetValue(settings.bypassed ? 0.f : 1.f);
+    wetRamp.assign(static_cast<size_t>(juce::jmax(1, maxBlockSize)), 1.f);
+    
+    const auto maxSlices = (static_cast<int>(spec.maximumBlockSize) + gainReductionSliceSize - 1) / gainReductionSliceSize;
+    sliceInputRMS.assign(static_cast<size_t>(juce::jmax(1, maxSlices)), 0.f);
 }
 
 /*!
-@brief Updates the compressor settings by setting the attack, release, threshold and ratio values from their corresponding audio parameters
+@brief Updates the compressor settings by setting the attack, release, threshold and ratio values, and keeps the rest for process() and the processor
 */
-void CompressorBand::updateCompressorSettings()
+void CompressorBand::updateCompressorSettings(const Settings& newSettings)
+{
+    settings = newSettings;
+    
+    attackCoefficient = makeCoefficient(settings.attack);
+    releaseCoefficient = makeCoefficient(settings.release);
+    
+    jassert(settings.ratio >= 1.f);
+    threshold = juce::Decibels::decibelsToGain(settings.threshold, -200.f);
+    thresholdInverse = 1.f / threshold;
+    ratioInverse = 1.f / settings.ratio;
+}
+
+float CompressorBand::makeCoefficient(float timeMs) const
 {
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue());
+    // as juce::dsp::BallisticsFilter computes it
+    if( timeMs < 1.0e-3f )
+        return 0.f;
+    
+    return static_cast<float>(std::exp(-2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate / timeMs));
 }
 
 /*!
  @brief Processes the audio buffer by either bypassing the processing or by applying the compression based on the bypass status
  @param buffer The audio buffer to be processed
 */
-void CompressorBand::process(juce::AudioBuffer<float>& buffer)
+void CompressorBand::process(juce::AudioBuffer<float>& buffer, const ChannelGroups& groups)
 {
     auto preRMS = computeRMSLevel(buffer);
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
-    
-    // Bypass the whole processBlock code (anything we would do is not done)
-    context.isBypassed = bypassed->get();
+    auto prePeak = computePeakLevel(buffer);
     
-    // We are just passing our context pointer to compressor overwriting it and another process will read from the same buffer to the output
-    compressor.process(context);
+    const auto numSamples = buffer.getNumSamples();
+    const auto numSlices = juce::jmin(static_cast<int>(sliceInputRMS.size()),
+                                      (numSamples + gainReductionSliceSize - 1) / gainReductionSliceSize);
+    for( int slice = 0; slice < numSlices; ++slice )
+    {
+        const auto start = slice * gainReductionSliceSize;
+        sliceInputRMS[static_cast<size_t>(slice)] = computeRMSLevel(buffer, start, juce::jmin(gainReductionSliceSize, numSamples - start));
+    }
+    // Bypass the whole processBlock code (anything we would do is not done), once the fade out of the
+    // compressed signal is over
+    wet.setTargetValue(settings.bypassed ? 0.f : 1.f);
+    if( ! settings.bypassed || wet.isSmoothing() )
+        compress(buffer, groups);
     
     auto postRMS = computeRMSLevel(buffer);
+    auto postPeak = computePeakLevel(buffer);
+    
+    // the RMS of every call since resetMeters(), weighted by its length
+    meterSums.inputSquares += static_cast<double>(preRMS) * preRMS * numSamples;
+    meterSums.outputSquares += static_cast<double>(postRMS) * postRMS * numSamples;
+    meterSums.numSamples += numSamples;
+    meterSums.inputPeak = juce::jmax(meterSums.inputPeak, prePeak);
+    meterSums.outputPeak = juce::jmax(meterSums.outputPeak, postPeak);
+    
+    updateGainReductionRange(buffer);
     
     auto convertToDb = [](auto input)
     {
         return juce::Decibels::gainToDecibels(input);
     };
     
-    rmsLevelInputDb.store(convertToDb(preRMS));
-    rmsLevelOutputDb.store(convertToDb(postRMS));
+    auto rmsOf = [n = meterSums.numSamples](double squares)
+    {
+        return n > 0 ? static_cast<float>(std::sqrt(squares / n)) : 0.f;
+    };
+    
+    meters.rmsInputDb = convertToDb(rmsOf(meterSums.inputSquares));
+    meters.rmsOutputDb = convertToDb(rmsOf(meterSums.outputSquares));
+    meters.peakInputDb = convertToDb(meterSums.inputPeak);
+    meters.peakOutputDb = convertToDb(meterSums.outputPeak);
+    meters.gainReductionDb = meters.rmsOutputDb - meters.rmsInputDb;
+    
+    meters.gainReductionMinDb = meterSums.numMeasured > 0 ? meterSums.gainReductionMinDb : 0.f;
+    meters.gainReductionMaxDb = meterSums.numMeasured > 0 ? meterSums.gainReductionMaxDb : 0.f;
+}
+
+void CompressorBand::compress(juce::AudioBuffer<float>& buffer, const ChannelGroups& groups)
+{
+    // a host may send more than the block size it prepared us for, the detector buffers only hold that much
+    const auto chunkSize = detectorRows.getNumSamples();
+    jassert(chunkSize > 0);
+    
+    for( int start = 0; chunkSize > 0 && start < buffer.getNumSamples(); start += chunkSize )
+        compressChunk(buffer, start, juce::jmin(chunkSize, buffer.getNumSamples() - start), groups);
+}
+
+void CompressorBand::compressChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const ChannelGroups& groups)
+{
+    using FVO = juce::FloatVectorOperations;
+    
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), detectorRows.getNumChannels(), ChannelLanes::MaxChannels);
+    const auto numGroups = juce::jmin(groups.numGroups, numChannels);
+    
+    // the processor makes the groups in prepareToPlay, for the channels it prepared us for
+    jassert(numGroups > 0);
+    if( numGroups == 0 )
+        return;
+    
+    // the fade to bypass can end in an earlier chunk of the block
+    if( ! wet.isSmoothing() && wet.getTargetValue() <= 0.f )
+        return;
+    
+    // every group's detector input is the loudest of its channels
+    for( int group = 0; group < numGroups; ++group )
+        FVO::clear(detectorRows.getWritePointer(group), numSamples);
+    
+    for( int channel = 0; channel < numChannels; ++channel )
+    {
+        auto* row = detectorRows.getWritePointer(groups.groupOf[static_cast<size_t>(channel)]);
+        const auto* input = buffer.getReadPointer(channel, startSample);
+        for( int i = 0; i < numSamples; ++i )
+            row[i] = juce::jmax(row[i], std::abs(input[i]));
+    }
+    
+    // the ballistics are recursive, so they run across the groups instead of across the samples
+    ChannelLanes::pack(detectorRows.getArrayOfReadPointers(), numGroups, 0, numSamples, packedDetectors.data());
+    
+    const auto attack = Vec::expand(attackCoefficient);
+    const auto release = Vec::expand(releaseCoefficient);
+    for( int laneGroup = 0; laneGroup < ChannelLanes::numGroups(numGroups); ++laneGroup )
+    {
+        auto* samples = packedDetectors.data() + laneGroup * numSamples;
+        auto envelope = envelopes[static_cast<size_t>(laneGroup)];
+        
+        for( int i = 0; i < numSamples; ++i )
+        {
+            const auto input = samples[i];
+            const auto rising = Vec::greaterThan(input, envelope);
+            const auto coefficient = (attack & rising) + (release & ~rising);
+            
+            envelope = input + coefficient * (envelope - input);
+            samples[i] = envelope;
+        }
+        
+        envelopes[static_cast<size_t>(laneGroup)] = envelope;
+    }
+    
+    ChannelLanes::unpack(packedDetectors.data(), numGroups, 0, numSamples, detectorRows.getArrayOfWritePointers());
+    
+    // the gain curve has no state, the envelopes become gains in place
+    const auto exponent = ratioInverse - 1.f;
+    for( int group = 0; group < numGroups; ++group )
+    {
+        auto* row = detectorRows.getWritePointer(group);
+        for( int i = 0; i < numSamples; ++i )
+            row[i] = row[i] < threshold ? 1.f : std::pow(row[i] * thresholdInverse, exponent);
+    }
+    
+    // while bypass fades in or out, a gain of 1 is the dry signal, so fading the gains fades the compression
+    if( wet.isSmoothing() )
+    {
+        for( int i = 0; i < numSamples; ++i )
+            wetRamp[static_cast<size_t>(i)] = wet.getNextValue();
+        
+        for( int group = 0; group < numGroups; ++group )
+        {
+            auto* row = detectorRows.getWritePointer(group);
+            for( int i = 0; i < numSamples; ++i )
+                row[i] = 1.f + wetRamp[static_cast<size_t>(i)] * (row[i] - 1.f);
+        }
+    }
+    
+    for( int channel = 0; channel < numChannels; ++channel )
+        FVO::multiply(buffer.getWritePointer(channel, startSample), detectorRows.getReadPointer(groups.groupOf[static_cast<size_t>(channel)]), numSamples);
+}
+
+void CompressorBand::updateGainReductionRange(const juce::AudioBuffer<float>& output)
+{
+    const auto numSamples = output.getNumSamples();
+    const auto numSlices = juce::jmin(static_cast<int>(sliceInputRMS.size()),
+                                      (numSamples + gainReductionSliceSize - 1) / gainReductionSliceSize);
+    
+    auto& minDb = meterSums.gainReductionMinDb;
+    auto& maxDb = meterSums.gainReductionMaxDb;
+    auto& numMeasured = meterSums.numMeasured;
+    
+    for( int slice = 0; slice < numSlices; ++slice )
+    {
+        const auto input = sliceInputRMS[static_cast<size_t>(slice)];
+        
+        // a silent slice says nothing about the gain
+        if( input < 1.0e-5f )
+            continue;
+        
+        const auto start = slice * gainReductionSliceSize;
+        const auto outputRMS = computeRMSLevel(output, start, juce::jmin(gainReductionSliceSize, numSamples - start));
+        const auto gainReduction = juce::jmin(0.f, juce::Decibels::gainToDecibels(outputRMS / input, NEGATIVE_INFINITY));
+        
+        minDb = juce::jmin(minDb, gainReduction);
+        maxDb = juce::jmax(maxDb, gainReduction);
+        ++numMeasured;
+    }
 }
@@ -11,53 +11,149 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../GUI/Utils.h"
+#include "MeterSnapshot.h"
+#include "ChannelLinking.h"
 
 
 /*!
  @class CompressorBand
- @brief CompressorBand class encapsulates all the audio parameters related to a band compressor and implements audio processing.
- This class holds the audio parameters such as attack, release, threshold, ratio, bypassed, mute, and solo. The prepare method sets up the compressor with the given process specification. The updateCompressorSettings method updates the parameters of the compressor. The process method processes the audio buffer.
+ @brief CompressorBand class encapsulates all the settings of a band compressor and implements audio processing.
+ This class holds the settings such as attack, release, threshold, ratio, bypassed, mute, and solo. The prepare method sets up the compressor with the given process specification. The updateCompressorSettings method updates the settings of the compressor, the processor passes them in once per block from the parameters or the snapshot morph. The process method processes the audio buffer.
  */
 struct CompressorBand
 {
-    juce::AudioParameterFloat* attack { nullptr };
-    juce::AudioParameterFloat* release { nullptr };
-    juce::AudioParameterFloat* threshold { nullptr };
-    juce::AudioParameterChoice* ratio { nullptr };
-    juce::AudioParameterBool* bypassed { nullptr };
-    juce::AudioParameterBool* mute { nullptr };
-    juce::AudioParameterBool* solo { nullptr };
+    struct Settings
+    {
+        float attack { 50.f };
+        float release { 250.f };
+        float threshold { 0.f };
+        /*! the ratio itself, not a choice index */
+        float ratio { 3.f };
+        bool bypassed { false };
+        bool mute { false };
+        bool solo { false };
+    };
+    
+    /*! switching bypass fades between the dry and the compressed band over this long, as long as a snapshot morph ramps */
+    static constexpr double bypassRampSeconds = 0.05;
     
+    /*! @brief Also jumps straight to the bypass state of the current settings. */
     void prepare(const juce::dsp::ProcessSpec& spec);
-    void updateCompressorSettings();
-    void process(juce::AudioBuffer<float>& buffer);
+    void updateCompressorSettings(const Settings& newSettings);
+    /*!
+     @param groups Which channels share a detector, see ChannelGroups.
+     */
+    void process(juce::AudioBuffer<float>& buffer, const ChannelGroups& groups);
+    
+    /*! @brief The settings of the last updateCompressorSettings() call. Audio thread only. */
+    const Settings& getSettings() const { return settings; }
     
-    float getRmsLevelInputDb() const { return rmsLevelInputDb; }
-    float getRmsLevelOutputDb() const { return rmsLevelOutputDb; }
+    /*!
+     @brief Starts measuring a new block. Every process() call until the next one adds to getMeters(), so a block
+     the processor handles in several chunks is still measured as a whole. Audio thread only.
+     */
+    void resetMeters() { meterSums = {}; }
+    
+    /*!
+     @brief The levels measured by the process() calls since resetMeters(). Audio thread only, the processor
+     publishes them to the GUI as part of its MeterSnapshot.
+     */
+    const BandMeters& getMeters() const { return meters; }
 private:
-    juce::dsp::Compressor<float> compressor;
+    Settings settings;
+    
+    /*!
+     @brief The compressor, the same peak detector and gain curve as juce::dsp::Compressor. Each group's
+     detector input is the loudest of its channels, the detectors run side by side in SIMD lanes, and every
+     channel is multiplied by its group's gain.
+     */
+    void compress(juce::AudioBuffer<float>& buffer, const ChannelGroups& groups);
+    /*! @brief compress(), for numSamples samples from startSample on, at most the prepared block size. */
+    void compressChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const ChannelGroups& groups);
+    
+    using Vec = ChannelLanes::Vec;
+    double sampleRate { 44100.0 };
+    /*! the ballistics, see juce::dsp::BallisticsFilter */
+    float attackCoefficient { 0.f }, releaseCoefficient { 0.f };
+    float threshold { 1.f }, thresholdInverse { 1.f }, ratioInverse { 1.f };
+    float makeCoefficient(float timeMs) const;
+    
+    /*! 1 while compressing, 0 while bypassed, ramping in between */
+    juce::SmoothedValue<float> wet;
+    /*! wet's values for the current chunk, sized in prepare() */
+    std::vector<float> wetRamp;
+    
+    /*! one detector per group, the envelope of each in its lane */
+    std::vector<Vec> envelopes;
+    /*! the detector inputs and then the gains, one row per group */
+    juce::AudioBuffer<float> detectorRows;
+    /*! the detector rows packed for the ballistics */
+    std::vector<Vec> packedDetectors;
+    
+    BandMeters meters;
+    
+    /*! what meters is made from, accumulated since resetMeters() */
+    struct MeterSums
+    {
+        double inputSquares { 0.0 }, outputSquares { 0.0 };
+        int numSamples { 0 };
+        float inputPeak { 0.f }, outputPeak { 0.f };
+        float gainReductionMinDb { 0.f }, gainReductionMaxDb { NEGATIVE_INFINITY };
+        int numMeasured { 0 };
+    };
+    MeterSums meterSums;
     
-    std::atomic<float> rmsLevelInputDb { NEGATIVE_INFINITY };
-    std::atomic<float> rmsLevelOutputDb { NEGATIVE_INFINITY };
+    /*! the gain reduction range within a block is measured over slices this long */
+    static constexpr int gainReductionSliceSize = 64;
+    /*! the input RMS of every slice of the current block, sized in prepare() */
+    std::vector<float> sliceInputRMS;
+    
+    /*!
+     @brief measures the gain reduction of every slice against sliceInputRMS and adds its range to meterSums.
+     */
+    void updateGainReductionRange(const juce::AudioBuffer<float>& output);
     
     /*!
      @brief computes the RMS or "average energy / loudness calc thingy" of the buffer.
      */
     template<typename T>
     float computeRMSLevel(const T& buffer)
+    {
+        return computeRMSLevel(buffer, 0, static_cast<int>(buffer.getNumSamples()));
+    }
+    
+    /*!
+     @brief the same, over numSamples samples from startSample on.
+     */
+    template<typename T>
+    float computeRMSLevel(const T& buffer, int startSample, int numSamples)
     {
         // get num channels and samples
         // compute rms of each channel and add all together
         // divide by num channels
         int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
         auto rms = 0.f;
         for(int chan = 0; chan < numChannels; ++chan)
         {
-            rms += buffer.getRMSLevel(chan, 0, numSamples);
+            rms += buffer.getRMSLevel(chan, startSample, numSamples);
         }
         
         rms /= static_cast<float>(numChannels);
         return rms;
     }
+    
+    /*!
+     @brief the largest absolute sample value across all channels of the buffer.
+     */
+    template<typename T>
+    float computePeakLevel(const T& buffer)
+    {
+        auto peak = 0.f;
+        for(int chan = 0; chan < buffer.getNumChannels(); ++chan)
+        {
+            peak = juce::jmax(peak, buffer.getMagnitude(chan, 0, buffer.getNumSamples()));
+        }
+        
+        return peak;
+    }
 };
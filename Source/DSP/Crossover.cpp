@@ -0,0 +1,129 @@
+/*
+ ==============================================================================
+
+ Crossover.cpp
+ Created: 19 Oct 2026 10:24:51pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "Crossover.h"
+
+namespace
+{
+    const auto R2 = Crossover::Vec::expand(juce::MathConstants<float>::sqrt2);
+
+    /*!
+     one TPT state variable section, the same arithmetic as juce::dsp::LinkwitzRileyFilter::processSample().
+     s holds the section's two states
+     */
+    template<typename Tuning>
+    inline void section(const Tuning& t, Crossover::Vec x, Crossover::Vec* s, Crossover::Vec& yH, Crossover::Vec& yB, Crossover::Vec& yL)
+    {
+        yH = (x - t.R2plusG * s[0] - s[1]) * t.h;
+
+        yB = t.g * yH + s[0];
+        s[0] = t.g * yH + yB;
+
+        yL = t.g * yB + s[1];
+        s[1] = t.g * yB + yL;
+    }
+
+    /*! an LR4 section: two state variable sections in series, s holds four states */
+    template<typename Tuning>
+    inline void linkwitzRiley(const Tuning& t, Crossover::Vec x, Crossover::Vec* s, Crossover::Vec& low, Crossover::Vec& high)
+    {
+        Crossover::Vec yH, yB, yL, yH2, yB2;
+        section(t, x, s, yH, yB, yL);
+        section(t, yL, s + 2, yH2, yB2, low);
+
+        high = yL - R2 * yB + yH - low;
+    }
+}
+
+void Crossover::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+    numChannelsPrepared = static_cast<int>(spec.numChannels);
+
+    const auto numGroups = static_cast<size_t>(ChannelLanes::numGroups(static_cast<int>(spec.numChannels)));
+    const auto packedSize = numGroups * static_cast<size_t>(maxBlockSize);
+
+    states.resize(numGroups);
+    packedInput.resize(packedSize);
+    for( auto& band : packedBands )
+        band.resize(packedSize);
+
+    reset();
+}
+
+void Crossover::reset()
+{
+    std::fill(states.begin(), states.end(), State {});
+}
+
+Crossover::Tuning Crossover::makeTuning(float frequency) const
+{
+    jassert(frequency > 0.f && frequency < sampleRate * 0.5);
+
+    const auto g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate));
+    const auto r2 = juce::MathConstants<float>::sqrt2;
+
+    return { Vec::expand(g), Vec::expand(1.f / (1.f + r2 * g + g * g)), Vec::expand(r2 + g) };
+}
+
+void Crossover::setCutoffFrequencies(float lowMidFrequency, float midHighFrequency)
+{
+    lowMid = makeTuning(lowMidFrequency);
+    midHigh = makeTuning(midHighFrequency);
+}
+
+void Crossover::process(const juce::AudioBuffer<float>& input,
+                        std::array<juce::AudioBuffer<float>, 3>& bands,
+                        int startSample,
+                        int numSamples)
+{
+    // a host may send more than the block size it prepared us for, the packed buffers only hold that much
+    jassert(maxBlockSize > 0);
+    for( int offset = 0; maxBlockSize > 0 && offset < numSamples; offset += maxBlockSize )
+        processChunk(input, bands, startSample + offset, juce::jmin(maxBlockSize, numSamples - offset));
+}
+
+void Crossover::processChunk(const juce::AudioBuffer<float>& input,
+                             std::array<juce::AudioBuffer<float>, 3>& bands,
+                             int startSample,
+                             int numSamples)
+{
+    const auto numChannels = juce::jmin(input.getNumChannels(), numChannelsPrepared);
+    const auto numGroups = ChannelLanes::numGroups(numChannels);
+
+    ChannelLanes::pack(input.getArrayOfReadPointers(), numChannels, startSample, numSamples, packedInput.data());
+
+    for( int group = 0; group < numGroups; ++group )
+    {
+        auto& state = states[static_cast<size_t>(group)];
+        const auto offset = static_cast<size_t>(group * numSamples);
+
+        const auto* x = packedInput.data() + offset;
+        auto* low = packedBands[0].data() + offset;
+        auto* mid = packedBands[1].data() + offset;
+        auto* high = packedBands[2].data() + offset;
+
+        for( int i = 0; i < numSamples; ++i )
+        {
+            Vec lowSide, highSide, yH, yB, yL;
+            linkwitzRiley(lowMid, x[i], state.lowMid.data(), lowSide, highSide);
+
+            // keeps the low band in phase with the two bands the mid-high split makes
+            section(midHigh, lowSide, state.allPass.data(), yH, yB, yL);
+            low[i] = yL - R2 * yB + yH;
+
+            linkwitzRiley(midHigh, highSide, state.midHigh.data(), mid[i], high[i]);
+        }
+    }
+
+    for( size_t band = 0; band < bands.size(); ++band )
+        ChannelLanes::unpack(packedBands[band].data(), numChannels, startSample, numSamples, bands[band].getArrayOfWritePointers());
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    FFTBackend.cpp
+    Created: 19 Oct 2026 1:58:20pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#include "FFTBackend.h"
+#include "RealFFT.h"
+
+namespace
+{
+    /*!
+     @brief FFTBackend on top of the bundled RealFFT.
+     */
+    struct BundledFFTBackend : FFTBackend
+    {
+        explicit BundledFFTBackend(int order) : fft(order) { }
+        
+        int getSize() const override { return fft.getSize(); }
+        juce::String getName() const override
+        {
+            return juce::String("RealFFT (") + RealFFT::getKernelName(fft.getKernel()) + ")";
+        }
+        
+        void performFrequencyOnlyForwardTransform(float* data) override { fft.forwardMagnitudes(data, data); }
+        void performRealOnlyForwardTransform(float* data) override { fft.forward(data, data); }
+        void performRealOnlyInverseTransform(float* data) override { fft.inverse(data, data); }
+    private:
+        RealFFT fft;
+    };
+    
+    /*!
+     @brief FFTBackend on top of juce::dsp::FFT.
+     */
+    struct JuceFFTBackend : FFTBackend
+    {
+        explicit JuceFFTBackend(int order) : fft(order) { }
+        
+        int getSize() const override { return fft.getSize(); }
+        juce::String getName() const override { return "juce::dsp::FFT"; }
+        
+        void performFrequencyOnlyForwardTransform(float* data) override
+        {
+            fft.performFrequencyOnlyForwardTransform(data, true);
+        }
+        void performRealOnlyForwardTransform(float* data) override
+        {
+            fft.performRealOnlyForwardTransform(data, true);
+        }
+        void performRealOnlyInverseTransform(float* data) override
+        {
+            fft.performRealOnlyInverseTransform(data);
+        }
+    private:
+        juce::dsp::FFT fft;
+    };
+}
+
+std::unique_ptr<FFTBackend> FFTBackend::create(int order, Type type)
+{
+    switch( type )
+    {
+        case Type::Juce:
+            return std::make_unique<JuceFFTBackend>(order);
+        case Type::Bundled:
+            break;
+    }
+    
+    return std::make_unique<BundledFFTBackend>(order);
+}
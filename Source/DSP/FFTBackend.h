@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    FFTBackend.h
+    Created: 19 Oct 2026 1:58:20pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class FFTBackend
+ @brief The interface everything that needs an FFT goes through (the analyzer's FFTDataGenerator, convolution).
+ Buffers follow juce::dsp::FFT's conventions: they hold 2 * getSize() floats, real signals sit in the first
+ getSize() floats and spectra are getSize()/2 + 1 interleaved (re, im) pairs.
+ Use create() to get one, implementations don't allocate once constructed.
+ */
+struct FFTBackend
+{
+    enum class Type
+    {
+        Bundled,    //!< RealFFT, our own SIMD real-input FFT. Needs no external library.
+        Juce        //!< juce::dsp::FFT, i.e. whatever engine JUCE was built with (IPP, vDSP, FFTW or its fallback)
+    };
+    
+    virtual ~FFTBackend() = default;
+    
+    virtual int getSize() const = 0;
+    /*! @brief A human readable name, e.g. for benchmark reports. */
+    virtual juce::String getName() const = 0;
+    
+    /*!
+     @brief Replaces the real signal in data with the magnitudes of bins 0 ... getSize()/2.
+     */
+    virtual void performFrequencyOnlyForwardTransform(float* data) = 0;
+    /*!
+     @brief Replaces the real signal in data with bins 0 ... getSize()/2 of its spectrum.
+     */
+    virtual void performRealOnlyForwardTransform(float* data) = 0;
+    /*!
+     @brief Replaces bins 0 ... getSize()/2 in data with the real signal, scaled so it undoes the forward transform.
+     */
+    virtual void performRealOnlyInverseTransform(float* data) = 0;
+    
+    /*!
+     @brief Creates an FFT of size 2^order.
+     The bundled backend picks its SIMD kernel for the CPU it is running on.
+     */
+    static std::unique_ptr<FFTBackend> create(int order, Type type = Type::Bundled);
+};
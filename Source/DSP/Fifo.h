@@ -14,26 +14,63 @@
 /*!
  @class Fifo
  @brief A template class that implements a First-In-First-Out (FIFO) queue.
- The Fifo class holds either std::vector<float> or juce::AudioBuffer<float> objects, and
- implements a FIFO queue to store and retrieve these objects. The capacity of the queue is fixed
- at 30.
- @tparam T The type of object to be held in the Fifo, either std::vector<float> or
- juce::AudioBuffer<float>.
+ The Fifo class holds std::vector<float>, juce::AudioBuffer<float>, juce::Path or SpectrumTrace objects, and
+ implements a FIFO queue to store and retrieve these objects. The capacity of the queue is a template
+ parameter and defaults to 30.
+ 
+ Besides the copying push()/pull() pair, the Fifo hands out scoped write()/read() handles that refer
+ directly to the slot inside the queue. Producers can fill a slot in place and consumers can swap its
+ contents out, so nothing gets copy-assigned (and nothing allocates) on either side.
+ @tparam T The type of object to be held in the Fifo, either std::vector<float>,
+ juce::AudioBuffer<float>, juce::Path or SpectrumTrace.
+ @tparam Capacity The number of slots in the queue.
  Example usage:
  @code
  Fifo<std::vector<float>> floatFifo;
  floatFifo.prepare(1024);
- std::vector<float> data;
- data.resize(1024, 0);
- floatFifo.push(data);
- std::vector<float> retrievedData;
- floatFifo.pull(retrievedData);
+ 
+ if( auto slot = floatFifo.write() )
+ {
+    std::fill(slot->begin(), slot->end(), 0.f); // written in place, committed when slot goes out of scope
+ }
+ 
+ if( auto slot = floatFifo.read() )
+ {
+    useData(*slot); // read in place, released when slot goes out of scope
+ }
  @endcode
  */
-template<typename T>
+template<typename T, int Capacity = 30>
 struct Fifo
 {
-
+    static_assert( Capacity > 1, "a Fifo needs at least 2 slots" );
+    
+    /*!
+     @brief A scoped reference to a single slot of the Fifo.
+     Evaluates to false when the queue was full (for writing) or empty (for reading). The slot is
+     committed back to the Fifo when the handle is destroyed, so keep its lifetime short.
+     */
+    template<typename ScopedType>
+    struct SlotHandle
+    {
+        SlotHandle(ScopedType&& s, std::array<T, Capacity>& buffers) :
+        scope(std::move(s)),
+        slot(scope.blockSize1 > 0 ? &buffers[static_cast<size_t>(scope.startIndex1)] : nullptr)
+        {
+        }
+        
+        explicit operator bool() const noexcept { return slot != nullptr; }
+        T& operator*() const noexcept { jassert(slot != nullptr); return *slot; }
+        T* operator->() const noexcept { jassert(slot != nullptr); return slot; }
+    private:
+        ScopedType scope;
+        T* slot { nullptr };
+        
+        JUCE_DECLARE_NON_COPYABLE(SlotHandle)
+    };
+    
+    using WriteHandle = SlotHandle<juce::AbstractFifo::ScopedWrite>;
+    using ReadHandle = SlotHandle<juce::AbstractFifo::ScopedRead>;
     
     /*!
     @brief Prepares the Fifo to hold juce::AudioBuffer<float> objects.
@@ -73,16 +110,46 @@ struct Fifo
     }
     
     /*!
-    @brief Pushes an object of type T onto the end of the queue.
+     @brief Frees the storage of every slot and empties the queue.
+     Only call this while nobody is reading from or writing to the queue.
+     */
+    void release()
+    {
+        for( auto& buffer : buffers )
+            buffer = T();
+        
+        fifo.reset();
+    }
+    
+    /*!
+     @brief Reserves a slot at the end of the queue for writing in place.
+     @return A handle to the slot. It is false if the queue is full.
+     */
+    WriteHandle write()
+    {
+        return WriteHandle(fifo.write(1), buffers);
+    }
+    
+    /*!
+     @brief Gives access to the slot at the front of the queue for reading in place.
+     @return A handle to the slot. It is false if the queue is empty.
+     */
+    ReadHandle read()
+    {
+        return ReadHandle(fifo.read(1), buffers);
+    }
+    
+    /*!
+    @brief Pushes a copy of an object of type T onto the end of the queue.
+    Prefer write() on the audio thread, copy-assigning T may allocate.
     @param t The object to be pushed onto the queue.
     @return True if the push was successful, false otherwise.
     */
     bool push(const T& t)
     {
-        auto write = fifo.write(1);
-        if( write.blockSize1 > 0 )
+        if( auto slot = write() )
         {
-            buffers[write.startIndex1] = t;
+            *slot = t;
             return true;
         }
         
@@ -90,17 +157,17 @@ struct Fifo
     }
     
     /*!
-    @brief Pulls an object of type T from the front of the queue.
+    @brief Pulls a copy of the object at the front of the queue.
+    Prefer read() when the slot can be used in place.
     @param t A reference to an object of type T that will be populated with the object from the front
     of the queue.
     @return True if the pull was successful, false otherwise.
     */
     bool pull(T& t)
     {
-        auto read = fifo.read(1);
-        if( read.blockSize1 > 0 )
+        if( auto slot = read() )
         {
-            t = buffers[read.startIndex1];
+            t = *slot;
             return true;
         }
         
@@ -116,8 +183,6 @@ struct Fifo
         return fifo.getNumReady();
     }
 private:
-    /** The maximum capacity of the queue. */
-    static constexpr int Capacity = 30;
     /** An array to store the objects in the queue. */
     std::array<T, Capacity> buffers;
     /** A juce::AbstractFifo to implement the FIFO queue. */
@@ -0,0 +1,72 @@
+/*
+ ==============================================================================
+
+ GainReductionRing.h
+ Created: 19 Oct 2026 8:02:17pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class GainReductionRing
+ @brief A lock-free queue of every band's gain reduction range, one entry per audio block.
+ The audio thread pushes one Block at the end of each processBlock(), the GUI drains whatever arrived since its
+ last frame. Unlike the MeterSnapshot, which only keeps the latest block, nothing in between is lost, so a
+ history display sees every block. When the GUI isn't draining, e.g. while the editor is closed, the ring
+ fills up and push() just drops the newest blocks.
+ @tparam NumBands The number of compressor bands.
+ @tparam Capacity The number of blocks the ring holds. 2048 blocks of 32 samples is over a second at 48 kHz,
+ far longer than the GUI ever waits between frames.
+ */
+template<size_t NumBands, int Capacity = 2048>
+struct GainReductionRing
+{
+    struct Block
+    {
+        /*! the range every band's gain reduction moved through, in decibels */
+        std::array<float, NumBands> minDb {};
+        std::array<float, NumBands> maxDb {};
+        /*! how much time the block covers */
+        int numSamples { 0 };
+    };
+
+    /*!
+     @brief Appends one block. Audio thread, never blocks or allocates.
+     @return false if the ring was full and the block was dropped.
+     */
+    bool push(const Block& block)
+    {
+        const auto scope = fifo.write(1);
+        if( scope.blockSize1 == 0 )
+            return false;
+
+        blocks[static_cast<size_t>(scope.startIndex1)] = block;
+        return true;
+    }
+
+    /*!
+     @brief Hands every block that's ready to the callback, oldest first, and removes them from the ring.
+     @param callback Called as callback(const Block&).
+     @return The number of blocks drained.
+     */
+    template<typename Callback>
+    int drain(Callback&& callback)
+    {
+        const auto scope = fifo.read(fifo.getNumReady());
+
+        for( int i = 0; i < scope.blockSize1; ++i )
+            callback(blocks[static_cast<size_t>(scope.startIndex1 + i)]);
+
+        for( int i = 0; i < scope.blockSize2; ++i )
+            callback(blocks[static_cast<size_t>(scope.startIndex2 + i)]);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+private:
+    std::array<Block, Capacity> blocks;
+    juce::AbstractFifo fifo { Capacity };
+};
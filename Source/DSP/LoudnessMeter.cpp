@@ -0,0 +1,169 @@
+/*
+ ==============================================================================
+
+ LoudnessMeter.cpp
+ Created: 19 Oct 2026 4:07:18pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "LoudnessMeter.h"
+
+/*!
+ @brief Computes the K-weighting filters for the sample rate.
+ The two stages are derived from their analog prototypes with the bilinear transform, so they match the 48 kHz
+ coefficients in BS.1770 and stay correct at any other sample rate.
+ @param sampleRate The sample rate of the audio that will be measured.
+ @param layout The channel layout of the audio, for the channel weights.
+ @param numChannels The number of channels that will be measured.
+ */
+void LoudnessMeter::prepare(double sampleRate, const juce::AudioChannelSet& layout, int numChannels)
+{
+    using namespace juce;
+
+    // stage 1, a high shelf modelling the acoustic effect of the head
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = float((vh + vb * k / q + k * k) / a0);
+        shelf.b1 = float(2.0 * (k * k - vh) / a0);
+        shelf.b2 = float((vh - vb * k / q + k * k) / a0);
+        shelf.a1 = float(2.0 * (k * k - 1.0) / a0);
+        shelf.a2 = float((1.0 - k / q + k * k) / a0);
+    }
+
+    // stage 2, the RLB high pass
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.f;
+        highPass.b1 = -2.f;
+        highPass.b2 = 1.f;
+        highPass.a1 = float(2.0 * (k * k - 1.0) / a0);
+        highPass.a2 = float((1.0 - k / q + k * k) / a0);
+    }
+
+    shelfState.assign(static_cast<size_t>(numChannels), {});
+    highPassState.assign(static_cast<size_t>(numChannels), {});
+
+    channelWeights.resize(static_cast<size_t>(numChannels));
+    for( int ch = 0; ch < numChannels; ++ch )
+        channelWeights[static_cast<size_t>(ch)] = ch < layout.size() ? getChannelWeight(layout.getTypeOfChannel(ch)) : 1.f;
+
+    samplesPerStep = jmax(1, roundToInt(sampleRate * 0.1));
+    reset();
+}
+
+/*!
+ @brief The BS.1770 weight of a channel: 1.41 for an ear level channel between 60 and 120 degrees off centre,
+ 0 for the LFE and 1.0 for the rest.
+ */
+float LoudnessMeter::getChannelWeight(juce::AudioChannelSet::ChannelType type)
+{
+    using CT = juce::AudioChannelSet::ChannelType;
+
+    switch( type )
+    {
+        case CT::LFE:
+        case CT::LFE2:
+            return 0.f;
+        case CT::leftSurround:
+        case CT::rightSurround:
+        case CT::leftSurroundSide:
+        case CT::rightSurroundSide:
+        case CT::wideLeft:
+        case CT::wideRight:
+            return 1.41f;
+        default:
+            return 1.f;
+    }
+}
+
+void LoudnessMeter::reset()
+{
+    std::fill(shelfState.begin(), shelfState.end(), BiquadState());
+    std::fill(highPassState.begin(), highPassState.end(), BiquadState());
+
+    stepPower.fill(0.0);
+    stepIndex = 0;
+    samplesInStep = 0;
+    powerInStep = 0.0;
+    momentaryPower = 0.0;
+}
+
+void LoudnessMeter::process(const juce::AudioBuffer<float>& buffer)
+{
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(shelfState.size()));
+    const auto numSamples = buffer.getNumSamples();
+
+    auto filter = [](const Biquad& c, BiquadState& s, float x)
+    {
+        const auto y = c.b0 * x + s.z1;
+        s.z1 = c.b1 * x - c.a1 * y + s.z2;
+        s.z2 = c.b2 * x - c.a2 * y;
+        return y;
+    };
+
+    int start = 0;
+    while( start < numSamples )
+    {
+        const auto chunk = juce::jmin(numSamples - start, samplesPerStep - samplesInStep);
+
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            const auto weight = channelWeights[static_cast<size_t>(ch)];
+            if( weight == 0.f )
+                continue;
+
+            const auto* samples = buffer.getReadPointer(ch, start);
+            auto& shelfZ = shelfState[static_cast<size_t>(ch)];
+            auto& highPassZ = highPassState[static_cast<size_t>(ch)];
+
+            float sumOfSquares = 0.f;
+            for( int i = 0; i < chunk; ++i )
+            {
+                const auto y = filter(highPass, highPassZ, filter(shelf, shelfZ, samples[i]));
+                sumOfSquares += y * y;
+            }
+
+            powerInStep += weight * sumOfSquares;
+        }
+
+        start += chunk;
+        samplesInStep += chunk;
+
+        if( samplesInStep == samplesPerStep )
+        {
+            stepPower[static_cast<size_t>(stepIndex)] = powerInStep / double(samplesPerStep);
+            stepIndex = (stepIndex + 1) % numSteps;
+
+            double sum = 0.0;
+            for( auto p : stepPower )
+                sum += p;
+            momentaryPower = sum / double(numSteps);
+
+            samplesInStep = 0;
+            powerInStep = 0.0;
+        }
+    }
+}
+
+float LoudnessMeter::getMomentaryLoudness(float minusInfinity) const
+{
+    if( momentaryPower <= 0.0 )
+        return minusInfinity;
+
+    return juce::jmax(minusInfinity, float(-0.691 + 10.0 * std::log10(momentaryPower)));
+}
@@ -0,0 +1,60 @@
+/*
+ ==============================================================================
+
+ LoudnessMeter.h
+ Created: 19 Oct 2026 4:07:18pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class LoudnessMeter
+ @brief Measures ITU-R BS.1770 momentary loudness (LUFS over the last 400 ms).
+ Each channel goes through the K-weighting pre-filter (a high shelf followed by a high pass), the filtered power
+ is summed over 100 ms steps and the last four steps are averaged, the 75% overlap the standard asks for.
+ The channels are weighted as BS.1770 does it: 1.41 for the surround channels at the sides of the listener,
+ 0 for the LFE and 1.0 for everything else, including channels the layout doesn't name. Nothing is allocated in process().
+ */
+struct LoudnessMeter
+{
+    /*!
+     @brief Computes the K-weighting coefficients for the sample rate, sizes the per channel state and takes the
+     channel weights from the layout.
+     */
+    void prepare(double sampleRate, const juce::AudioChannelSet& layout, int numChannels);
+    void reset();
+
+    /*! @brief Audio thread. Channels beyond the prepared count are ignored. */
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    /*! @return the momentary loudness in LUFS, floored at the given value */
+    float getMomentaryLoudness(float minusInfinity) const;
+private:
+    struct Biquad
+    {
+        float b0 { 1.f }, b1 { 0.f }, b2 { 0.f }, a1 { 0.f }, a2 { 0.f };
+    };
+
+    /*! transposed direct form II state of one biquad */
+    struct BiquadState
+    {
+        float z1 { 0.f }, z2 { 0.f };
+    };
+
+    Biquad shelf, highPass;
+    std::vector<BiquadState> shelfState, highPassState;
+    std::vector<float> channelWeights;
+    static float getChannelWeight(juce::AudioChannelSet::ChannelType type);
+
+    static constexpr int numSteps = 4;
+    std::array<double, numSteps> stepPower {};
+    int stepIndex { 0 };
+    int samplesPerStep { 0 };
+    int samplesInStep { 0 };
+    double powerInStep { 0.0 };
+    double momentaryPower { 0.0 };
+};
@@ -0,0 +1,47 @@
+/*
+ ==============================================================================
+
+ MeterSnapshot.h
+ Created: 19 Oct 2026 3:52:40pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "../GUI/Utils.h"
+
+/*!
+ @brief The levels of one compressor band over the last block, all in decibels.
+ */
+struct BandMeters
+{
+    float rmsInputDb { NEGATIVE_INFINITY };
+    float rmsOutputDb { NEGATIVE_INFINITY };
+    float peakInputDb { NEGATIVE_INFINITY };
+    float peakOutputDb { NEGATIVE_INFINITY };
+    /*! rmsOutputDb - rmsInputDb, negative while the band is compressing */
+    float gainReductionDb { 0.f };
+    /*! the range the gain reduction moved through within the block, measured over short slices of it */
+    float gainReductionMinDb { 0.f };
+    float gainReductionMaxDb { 0.f };
+};
+
+/*!
+ @class MeterSnapshot
+ @brief Every meter the editor shows, taken at the end of one audio block.
+ The processor fills one of these per block and publishes it through a TripleBuffer, so the GUI always sees
+ values that belong to the same block and reading them allocates nothing.
+ @tparam NumBands The number of compressor bands.
+ */
+template<size_t NumBands>
+struct MeterSnapshot
+{
+    std::array<BandMeters, NumBands> bands {};
+
+    float outputRmsDb { NEGATIVE_INFINITY };
+    float outputPeakDb { NEGATIVE_INFINITY };
+    /*! ITU-R BS.1770 momentary loudness, see LoudnessMeter */
+    float momentaryLufs { NEGATIVE_INFINITY };
+};
@@ -0,0 +1,136 @@
+/*
+ ==============================================================================
+
+ MultiChannelSampleFifo.h
+ Created: 19 Oct 2026 9:41:12am
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "Fifo.h"
+
+/*!
+ @brief Which signal the analyzer derives from a captured multichannel buffer.
+ Left and Right are channels 0 and 1, Mid is (L + R) / 2, Side is (L - R) / 2 and Sum is the average of every
+ captured channel. A mono capture maps Left, Right, Mid and Sum onto its single channel and Side onto silence.
+ */
+enum class AnalyzerChannel
+{
+    Left,
+    Right,
+    Mid,
+    Side,
+    Sum
+};
+
+/*!
+ @class MultiChannelSampleFifo
+ @brief Captures every channel of the audio stream into fixed size buffers for the analyzer.
+ Instead of one fifo per channel, update() walks the incoming buffer once and copies each
+ channel with a single FloatVectorOperations::copy per chunk, so the capture cost does not depend on how many
+ signals the analyzer derives from it. Complete buffers are swapped into the Fifo, never copied.
+ Works for mono, stereo and surround layouts, the channel count is fixed in prepare().
+ @tparam BlockType The type of audio block being managed, juce::AudioBuffer<float>.
+ */
+template<typename BlockType>
+struct MultiChannelSampleFifo
+{
+    MultiChannelSampleFifo()
+    {
+        prepared.set(false);
+    }
+
+    /*!
+     @brief Copies the incoming block into the buffer being filled, pushing it to the Fifo whenever it is full.
+     Channels beyond the prepared channel count are ignored.
+     @param buffer The block coming from processBlock.
+     */
+    void update(const BlockType& buffer)
+    {
+        jassert(prepared.get());
+
+        const auto numChannels = juce::jmin(buffer.getNumChannels(), bufferToFill.getNumChannels());
+        const auto numSamples = buffer.getNumSamples();
+        const auto bufferSize = bufferToFill.getNumSamples();
+
+        if( bufferSize == 0 )
+            return;
+
+        int readIndex = 0;
+        while( readIndex < numSamples )
+        {
+            auto chunk = juce::jmin(numSamples - readIndex, bufferSize - fifoIndex);
+
+            for( int ch = 0; ch < numChannels; ++ch )
+            {
+                juce::FloatVectorOperations::copy(bufferToFill.getWritePointer(ch, fifoIndex),
+                                                  buffer.getReadPointer(ch, readIndex),
+                                                  chunk);
+            }
+
+            readIndex += chunk;
+            fifoIndex += chunk;
+
+            if( fifoIndex == bufferSize )
+            {
+                // hand the filled buffer over by swapping it with the (equally sized) slot, no copy
+                if( auto slot = audioBufferFifo.write() )
+                {
+                    std::swap(*slot, bufferToFill);
+                }
+
+                fifoIndex = 0;
+            }
+        }
+    }
+
+    /*!
+     @brief Sizes the buffer being filled and every Fifo slot. Call this while the audio thread is stopped.
+     @param numChannels The number of channels to capture.
+     @param bufferSize The number of samples in each captured buffer.
+     */
+    void prepare(int numChannels, int bufferSize)
+    {
+        prepared.set(false);
+        size.set(bufferSize);
+
+        bufferToFill.setSize(numChannels,   //channels
+                             bufferSize,    //num samples
+                             false,         //keepExistingContent
+                             true,          //clear extra space
+                             true);         //avoid reallocating
+        bufferToFill.clear();
+        audioBufferFifo.prepare(numChannels, bufferSize);
+        fifoIndex = 0;
+        prepared.set(true);
+    }
+
+    /*!
+     @brief Frees the capture buffers. Call this while the audio thread is stopped or no longer calls update().
+     */
+    void release()
+    {
+        prepared.set(false);
+        size.set(0);
+
+        bufferToFill = BlockType();
+        audioBufferFifo.release();
+        fifoIndex = 0;
+    }
+    //==============================================================================
+    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
+    bool isPrepared() const { return prepared.get(); }
+    int getSize() const { return size.get(); }
+    //==============================================================================
+    /*! @brief In-place access to the oldest complete buffer, see Fifo::read(). */
+    typename Fifo<BlockType>::ReadHandle readAudioBuffer() { return audioBufferFifo.read(); }
+private:
+    int fifoIndex = 0;
+    Fifo<BlockType> audioBufferFifo;
+    BlockType bufferToFill;
+    juce::Atomic<bool> prepared = false;
+    juce::Atomic<int> size = 0;
+};
@@ -0,0 +1,60 @@
+/*
+ ==============================================================================
+
+ ParameterVersion.h
+ Created: 19 Oct 2026 8:41:09pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class ParameterVersion
+ @brief A counter that goes up whenever any parameter of the processor changed, for GUIs to poll.
+ update() compares every parameter with the value it saw last and bumps the version if any of them moved. A
+ reader remembers the version it last drew and redraws when it differs, so nobody has to register a
+ juce::AudioProcessorParameter::Listener, whose callbacks run synchronously on whatever thread changed the
+ parameter, the audio thread included.
+ update() is lock-free and may run on several threads at once: the last seen values are atomics, and two threads
+ seeing the same change only bump the version twice, which costs one extra redraw at worst.
+ */
+struct ParameterVersion
+{
+    /*!
+     @brief Takes the parameters and their current values. Call once, after every parameter was added.
+     */
+    void prepare(const juce::Array<juce::AudioProcessorParameter*>& params)
+    {
+        parameters = params;
+        lastValues = std::make_unique<std::atomic<float>[]>(static_cast<size_t>(parameters.size()));
+
+        for( int i = 0; i < parameters.size(); ++i )
+            lastValues[static_cast<size_t>(i)].store(parameters.getUnchecked(i)->getValue());
+    }
+
+    /*!
+     @brief Bumps the version if any parameter changed since the last call. Never blocks or allocates.
+     */
+    void update()
+    {
+        auto changed = false;
+
+        for( int i = 0; i < parameters.size(); ++i )
+        {
+            const auto value = parameters.getUnchecked(i)->getValue();
+            changed |= lastValues[static_cast<size_t>(i)].exchange(value, std::memory_order_relaxed) != value;
+        }
+
+        if( changed )
+            version.fetch_add(1, std::memory_order_release);
+    }
+
+    uint32_t get() const { return version.load(std::memory_order_acquire); }
+private:
+    juce::Array<juce::AudioProcessorParameter*> parameters;
+    std::unique_ptr<std::atomic<float>[]> lastValues;
+    std::atomic<uint32_t> version { 0 };
+};
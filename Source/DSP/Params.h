@@ -10,88 +10,333 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "../GUI/Utils.h"
 
 /*!
 @file Params.h
-@brief This file holds the definition of the Params namespace which contains the enumeration of all the parameters of the audio processor and a function to get the parameters and their names.
+@brief This file holds the definition of the Params namespace: the enumeration of all the parameters of the audio processor, a compile time table of their IDs, types, ranges and defaults, and O(1) typed access to the parameter objects.
+The table drives createParameterLayout(), so a parameter's Names value is also its index in AudioProcessor::getParameters(). Looking a parameter up is an array index, no string is hashed or compared.
 */
 namespace Params
 {
+    /*! the number of compressor bands the table is generated for */
+    inline constexpr size_t NumBands = 3;
+
+    /*! every band's display name, low to high */
+    inline constexpr std::array<const char*, NumBands> BandNames { "Low", "Mid", "High" };
+
+    /*!
+     Every parameter, in the order createParameterLayout() adds them. Hosts may address parameters by index,
+     so new parameters go at the end. The per-band parameters come in runs of NumBands, low to high, see forBand().
+     */
     enum Names
     {
-        Low_Mid_Crossover_Freq,
-        Mid_High_Crossover_Freq,
-        
+        Gain_In,
+        Gain_Out,
+
         Threshold_Low_Band,
         Threshold_Mid_Band,
         Threshold_High_Band,
-        
+
         Attack_Low_Band,
         Attack_Mid_Band,
         Attack_High_Band,
-        
+
         Release_Low_Band,
         Release_Mid_Band,
         Release_High_Band,
-        
+
         Ratio_Low_Band,
         Ratio_Mid_Band,
         Ratio_High_Band,
-        
-        Bypassed_Low_Band,
-        Bypassed_Mid_Band,
-        Bypassed_High_Band,
-        
-        Mute_Low_Band,
-        Mute_Mid_Band,
-        Mute_High_Band,
-        
+
         Solo_Low_Band,
         Solo_Mid_Band,
         Solo_High_Band,
-        
-        Gain_In,
-        Gain_Out,
+
+        Mute_Low_Band,
+        Mute_Mid_Band,
+        Mute_High_Band,
+
+        Bypassed_Low_Band,
+        Bypassed_Mid_Band,
+        Bypassed_High_Band,
+
+        Low_Mid_Crossover_Freq,
+        Mid_High_Crossover_Freq,
+
+        Channel_Link,
+    };
+
+    inline constexpr size_t NumParams = static_cast<size_t>(Channel_Link) + 1;
+
+    /*! the parameters every band has, in the order of their runs in Names */
+    enum class BandParam
+    {
+        Threshold,
+        Attack,
+        Release,
+        Ratio,
+        Solo,
+        Mute,
+        Bypassed
     };
-    
-    inline const std::map<Names, juce::String>& GetParams()
+
+    inline constexpr size_t NumBandParams = static_cast<size_t>(BandParam::Bypassed) + 1;
+
+    /*!
+     @brief The Names value of one band's parameter, e.g. forBand(BandParam::Attack, 1) is Attack_Mid_Band.
+     */
+    constexpr Names forBand(BandParam param, size_t band)
+    {
+        return static_cast<Names>(static_cast<size_t>(Threshold_Low_Band) + static_cast<size_t>(param) * NumBands + band);
+    }
+
+    static_assert( forBand(BandParam::Ratio, 1) == Ratio_Mid_Band, "the band runs in Names are out of order" );
+    static_assert( forBand(BandParam::Bypassed, NumBands - 1) + 1 == Low_Mid_Crossover_Freq, "the band runs in Names are out of order" );
+
+    enum class Type
+    {
+        Float,
+        Choice,
+        Bool
+    };
+
+    /*! the ratios the Ratio parameters choose from */
+    inline constexpr std::array<float, 14> RatioChoices { 1.f, 1.5f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 10.f, 15.f, 20.f, 50.f, 100.f };
+
+    /*! the choices of Channel_Link, in ChannelLink order */
+    inline constexpr std::array<const char*, 3> ChannelLinkChoices { "Link Off", "Link Pairs", "Link All" };
+
+    /*!
+     @brief Everything createParameterLayout() needs to know about one parameter.
+     */
+    struct Spec
     {
-        static std::map<Names, juce::String> params = {
-            {Low_Mid_Crossover_Freq, "Low-Mid Crossover Freq"},
-            {Mid_High_Crossover_Freq, "Mid-High Crossover Freq"},
-            
-            {Threshold_Low_Band, "Threshold Low Band"},
-            {Threshold_Mid_Band, "Threshold Mid Band"},
-            {Threshold_High_Band, "Threshold High Band"},
-            
-            {Attack_Low_Band, "Attack Low Band"},
-            {Attack_Mid_Band, "Attack Mid Band"},
-            {Attack_High_Band, "Attack High Band"},
-            
-            {Release_Low_Band, "Release Low Band"},
-            {Release_Mid_Band, "Release Mid Band"},
-            {Release_High_Band, "Release High Band"},
-            
-            {Ratio_Low_Band, "Ratio Low Band"},
-            {Ratio_Mid_Band, "Ratio Mid Band"},
-            {Ratio_High_Band, "Ratio High Band"},
-            
-            {Bypassed_Low_Band, "Bypassed Low Band"},
-            {Bypassed_Mid_Band, "Bypassed Mid Band"},
-            {Bypassed_High_Band, "Bypassed High Band"},
-            
-            {Mute_Low_Band, "Mute Low Band"},
-            {Mute_Mid_Band, "Mute Mid Band"},
-            {Mute_High_Band, "Mute High Band"},
-            
-            {Solo_Low_Band, "Solo Low Band"},
-            {Solo_Mid_Band, "Solo Mid Band"},
-            {Solo_High_Band, "Solo High Band"},
-            
-            {Gain_In, "Gain In"},
-            {Gain_Out, "Gain Out"},
-        };
-        
-        return params;
+        /*! the parameter ID and its name. Saved sessions refer to it, so never change it */
+        const char* id;
+        Type type;
+        /*! the range of a Float */
+        float minimum, maximum, interval, skew;
+        /*! a Float's value, a Choice's index or a Bool's 0 or 1 */
+        float defaultValue;
+        /*! the choices of a Choice, as numbers, or as names when choiceNames is set */
+        const float* choices;
+        size_t numChoices;
+        const char* const* choiceNames;
+    };
+
+    namespace detail
+    {
+        constexpr Spec floatSpec(const char* id, float minimum, float maximum, float interval, float skew, float defaultValue)
+        {
+            return { id, Type::Float, minimum, maximum, interval, skew, defaultValue, nullptr, 0, nullptr };
+        }
+
+        constexpr Spec ratioSpec(const char* id, size_t defaultIndex)
+        {
+            return { id, Type::Choice, 0.f, 0.f, 0.f, 1.f, float(defaultIndex), RatioChoices.data(), RatioChoices.size(), nullptr };
+        }
+
+        template<size_t NumChoices>
+        constexpr Spec namedChoiceSpec(const char* id, const std::array<const char*, NumChoices>& names, size_t defaultIndex)
+        {
+            return { id, Type::Choice, 0.f, 0.f, 0.f, 1.f, float(defaultIndex), nullptr, NumChoices, names.data() };
+        }
+
+        constexpr Spec boolSpec(const char* id, bool defaultValue)
+        {
+            return { id, Type::Bool, 0.f, 1.f, 1.f, 1.f, defaultValue ? 1.f : 0.f, nullptr, 0, nullptr };
+        }
+
+        /*! the IDs of the per-band parameters, one row per BandParam */
+        inline constexpr std::array<std::array<const char*, NumBands>, NumBandParams> BandIDs
+        {{
+            { "Threshold Low Band", "Threshold Mid Band", "Threshold High Band" },
+            { "Attack Low Band", "Attack Mid Band", "Attack High Band" },
+            { "Release Low Band", "Release Mid Band", "Release High Band" },
+            { "Ratio Low Band", "Ratio Mid Band", "Ratio High Band" },
+            { "Solo Low Band", "Solo Mid Band", "Solo High Band" },
+            { "Mute Low Band", "Mute Mid Band", "Mute High Band" },
+            { "Bypassed Low Band", "Bypassed Mid Band", "Bypassed High Band" },
+        }};
+
+        constexpr const char* bandID(BandParam param, size_t band)
+        {
+            return BandIDs[static_cast<size_t>(param)][band];
+        }
+
+        constexpr std::array<Spec, NumParams> makeTable()
+        {
+            std::array<Spec, NumParams> table {};
+
+            // Gain
+            table[Gain_In] = floatSpec("Gain In", -24.f, 24.f, 0.5f, 1.5f, 0.f);
+            table[Gain_Out] = floatSpec("Gain Out", -24.f, 24.f, 0.5f, 1.5f, 0.f);
+
+            for( size_t band = 0; band < NumBands; ++band )
+            {
+                table[forBand(BandParam::Threshold, band)] = floatSpec(bandID(BandParam::Threshold, band), MIN_THRESHOLD, MAX_DECIBALS, 1.f, 1.f, 0.f);
+                table[forBand(BandParam::Attack, band)] = floatSpec(bandID(BandParam::Attack, band), 5.f, 500.f, 1.f, 1.f, 50.f);
+                table[forBand(BandParam::Release, band)] = floatSpec(bandID(BandParam::Release, band), 5.f, 500.f, 1.f, 1.f, 250.f);
+                table[forBand(BandParam::Ratio, band)] = ratioSpec(bandID(BandParam::Ratio, band), 3);
+                table[forBand(BandParam::Solo, band)] = boolSpec(bandID(BandParam::Solo, band), false);
+                table[forBand(BandParam::Mute, band)] = boolSpec(bandID(BandParam::Mute, band), false);
+                table[forBand(BandParam::Bypassed, band)] = boolSpec(bandID(BandParam::Bypassed, band), false);
+            }
+
+            // Crossovers
+            table[Low_Mid_Crossover_Freq] = floatSpec("Low-Mid Crossover Freq", 20.f, 999.f, 1.f, 1.f, 400.f);
+            table[Mid_High_Crossover_Freq] = floatSpec("Mid-High Crossover Freq", 1000.f, 20000.f, 1.f, 1.f, 2000.f);
+
+            // Detection
+            table[Channel_Link] = namedChoiceSpec("Channel Link", ChannelLinkChoices, 0);
+
+            return table;
+        }
+
+        template<typename ParamType>
+        constexpr Type typeOf()
+        {
+            if constexpr ( std::is_same_v<ParamType, juce::AudioParameterFloat> )
+                return Type::Float;
+            else if constexpr ( std::is_same_v<ParamType, juce::AudioParameterChoice> )
+                return Type::Choice;
+            else
+            {
+                static_assert( std::is_same_v<ParamType, juce::AudioParameterBool>, "parameters are Float, Choice or Bool" );
+                return Type::Bool;
+            }
+        }
+    }
+
+    /*! every parameter's Spec, indexed by Names */
+    inline constexpr std::array<Spec, NumParams> Table = detail::makeTable();
+
+    /*!
+     @brief The parameter's ID, as createParameterLayout() registered it.
+     */
+    inline juce::String getID(Names name)
+    {
+        return Table[name].id;
+    }
+
+    /*!
+     @brief Every parameter of the table, as AudioParameterFloat, AudioParameterChoice and AudioParameterBool,
+     added in Names order, which makes a parameter's Names value its index in getParameters().
+     */
+    inline juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
+    {
+        juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+        for( const auto& spec : Table )
+        {
+            const auto id = juce::ParameterID { spec.id, 1 };
+
+            switch( spec.type )
+            {
+                case Type::Float:
+                    layout.add(std::make_unique<juce::AudioParameterFloat>(id,
+                                                                           spec.id,
+                                                                           juce::NormalisableRange<float>(spec.minimum, spec.maximum, spec.interval, spec.skew),
+                                                                           spec.defaultValue));
+                    break;
+                case Type::Choice:
+                {
+                    juce::StringArray choices;
+                    for( size_t i = 0; i < spec.numChoices; ++i )
+                        choices.add(spec.choiceNames != nullptr ? juce::String(spec.choiceNames[i]) : juce::String(spec.choices[i], 1));
+
+                    layout.add(std::make_unique<juce::AudioParameterChoice>(id,
+                                                                            spec.id,
+                                                                            choices,
+                                                                            static_cast<int>(spec.defaultValue)));
+                    break;
+                }
+                case Type::Bool:
+                    layout.add(std::make_unique<juce::AudioParameterBool>(id,
+                                                                          spec.id,
+                                                                          spec.defaultValue > 0.5f));
+                    break;
+            }
+        }
+
+        return layout;
+    }
+
+    /*!
+     @brief The parameter object. O(1): its Names value is its index in the processor's parameter list.
+     */
+    inline juce::RangedAudioParameter& get(juce::AudioProcessorValueTreeState& apvts, Names name)
+    {
+        auto* param = static_cast<juce::RangedAudioParameter*>(apvts.processor.getParameters().getUnchecked(name));
+        jassert(param != nullptr && param->getParameterID() == Table[name].id);
+
+        return *param;
+    }
+
+    /*!
+     @brief The same, as the type the table says it is, e.g. get<juce::AudioParameterBool>(apvts, Names::Mute_Low_Band).
+     */
+    template<typename ParamType>
+    ParamType& get(juce::AudioProcessorValueTreeState& apvts, Names name)
+    {
+        jassert(Table[name].type == detail::typeOf<ParamType>());
+        return static_cast<ParamType&>(get(apvts, name));
+    }
+
+    /*!
+     every parameter's plain value, indexed by Names: a Float's value, a Choice's index or a Bool's 0 or 1. The
+     snapshot morph produces values in between, a fractional Choice index or a Bool that isn't 0 or 1.
+     */
+    using Values = std::array<float, NumParams>;
+
+    /*!
+     @brief Reads every parameter's current value. Never blocks or allocates, the audio thread calls it once per block.
+     */
+    inline void readValues(juce::AudioProcessorValueTreeState& apvts, Values& values)
+    {
+        for( size_t i = 0; i < NumParams; ++i )
+        {
+            const auto name = static_cast<Names>(i);
+            switch( Table[i].type )
+            {
+                case Type::Float: values[i] = get<juce::AudioParameterFloat>(apvts, name).get(); break;
+                case Type::Choice: values[i] = static_cast<float>(get<juce::AudioParameterChoice>(apvts, name).getIndex()); break;
+                case Type::Bool: values[i] = get<juce::AudioParameterBool>(apvts, name).get() ? 1.f : 0.f; break;
+            }
+        }
+    }
+
+    /*!
+     @brief Sets every parameter that differs from values, each as one gesture so the host records it. Message thread only.
+     Fractional Choice indices go to the nearest choice and Bools to the nearer of 0 and 1.
+     */
+    inline void writeValues(juce::AudioProcessorValueTreeState& apvts, const Values& values)
+    {
+        for( size_t i = 0; i < NumParams; ++i )
+        {
+            auto& param = get(apvts, static_cast<Names>(i));
+            const auto value = param.convertTo0to1(Table[i].type == Type::Float ? values[i] : std::round(values[i]));
+            if( param.getValue() == value )
+                continue;
+
+            param.beginChangeGesture();
+            param.setValueNotifyingHost(value);
+            param.endChangeGesture();
+        }
+    }
+
+    /*!
+     @brief The ratio of a Ratio parameter's choice index. A fractional index lies on the straight line between
+     its two neighbouring choices, so a morph sweeps the ratio smoothly instead of stepping through the choices.
+     */
+    inline float ratioAt(float index)
+    {
+        const auto clamped = juce::jlimit(0.f, float(RatioChoices.size() - 1), index);
+        const auto lower = juce::jmin(static_cast<size_t>(clamped), RatioChoices.size() - 2);
+        const auto fraction = clamped - float(lower);
+
+        return RatioChoices[lower] + (RatioChoices[lower + 1] - RatioChoices[lower]) * fraction;
     }
 }
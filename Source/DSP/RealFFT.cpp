@@ -0,0 +1,444 @@
+/*
+  ==============================================================================
+
+    RealFFT.cpp
+    Created: 19 Oct 2026 1:14:52pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#include "RealFFT.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+ #define REALFFT_HAS_SSE 1
+ #define REALFFT_HAS_AVX 1
+ // lets the AVX kernel live next to the SSE one without building the whole plugin with -mavx
+ #if defined(__GNUC__) || defined(__clang__)
+  #define REALFFT_AVX_TARGET __attribute__((target("avx")))
+ #else
+  #define REALFFT_AVX_TARGET
+ #endif
+#endif
+
+#if JUCE_ARM && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+ #include <arm_neon.h>
+ #define REALFFT_HAS_NEON 1
+#endif
+
+namespace
+{
+    /*!
+     @brief Plain radix-2 butterflies for one stage.
+     For every group of 2 * span values: t = w[j] * v[j + span], v[j + span] = v[j] - t, v[j] += t.
+     */
+    inline void butterflies(float* re, float* im, const float* wr, const float* wi,
+                            int n, int span) noexcept
+    {
+        for( int group = 0; group < n; group += 2 * span )
+        {
+            auto* aRe = re + group;
+            auto* aIm = im + group;
+            auto* bRe = aRe + span;
+            auto* bIm = aIm + span;
+
+            for( int j = 0; j < span; ++j )
+            {
+                const auto tRe = wr[j] * bRe[j] - wi[j] * bIm[j];
+                const auto tIm = wr[j] * bIm[j] + wi[j] * bRe[j];
+                bRe[j] = aRe[j] - tRe;
+                bIm[j] = aIm[j] - tIm;
+                aRe[j] += tRe;
+                aIm[j] += tIm;
+            }
+        }
+    }
+
+    /*!
+     @brief Spans 1 and 2 fused into one radix-4 pass. Their twiddles are 1 and -i, so no multiplies are needed,
+     and these stages are too narrow for the SIMD kernels anyway.
+     */
+    void firstTwoStages(float* re, float* im, int n) noexcept
+    {
+        for( int group = 0; group < n; group += 4 )
+        {
+            auto* r = re + group;
+            auto* m = im + group;
+
+            const auto a0Re = r[0] + r[1], a0Im = m[0] + m[1];
+            const auto a1Re = r[0] - r[1], a1Im = m[0] - m[1];
+            const auto a2Re = r[2] + r[3], a2Im = m[2] + m[3];
+            const auto a3Re = r[2] - r[3], a3Im = m[2] - m[3];
+
+            r[0] = a0Re + a2Re;  m[0] = a0Im + a2Im;
+            r[2] = a0Re - a2Re;  m[2] = a0Im - a2Im;
+            // -i * a3 = (a3Im, -a3Re)
+            r[1] = a1Re + a3Im;  m[1] = a1Im - a3Re;
+            r[3] = a1Re - a3Im;  m[3] = a1Im + a3Re;
+        }
+    }
+
+    void stageScalar(float* re, float* im, const float* wr, const float* wi, int n, int span) noexcept
+    {
+        butterflies(re, im, wr, wi, n, span);
+    }
+
+#if REALFFT_HAS_SSE
+    void stageSSE(float* re, float* im, const float* wr, const float* wi, int n, int span) noexcept
+    {
+        // spans are powers of 2, so they are either smaller than a vector or a multiple of it
+        if( span < 4 )
+            return butterflies(re, im, wr, wi, n, span);
+
+        for( int group = 0; group < n; group += 2 * span )
+        {
+            auto* aRe = re + group;
+            auto* aIm = im + group;
+            auto* bRe = aRe + span;
+            auto* bIm = aIm + span;
+
+            for( int j = 0; j < span; j += 4 )
+            {
+                const auto wRe = _mm_loadu_ps(wr + j);
+                const auto wIm = _mm_loadu_ps(wi + j);
+                const auto xRe = _mm_loadu_ps(bRe + j);
+                const auto xIm = _mm_loadu_ps(bIm + j);
+                const auto yRe = _mm_loadu_ps(aRe + j);
+                const auto yIm = _mm_loadu_ps(aIm + j);
+
+                const auto tRe = _mm_sub_ps(_mm_mul_ps(wRe, xRe), _mm_mul_ps(wIm, xIm));
+                const auto tIm = _mm_add_ps(_mm_mul_ps(wRe, xIm), _mm_mul_ps(wIm, xRe));
+
+                _mm_storeu_ps(bRe + j, _mm_sub_ps(yRe, tRe));
+                _mm_storeu_ps(bIm + j, _mm_sub_ps(yIm, tIm));
+                _mm_storeu_ps(aRe + j, _mm_add_ps(yRe, tRe));
+                _mm_storeu_ps(aIm + j, _mm_add_ps(yIm, tIm));
+            }
+        }
+    }
+#endif
+
+#if REALFFT_HAS_AVX
+    REALFFT_AVX_TARGET
+    void stageAVX(float* re, float* im, const float* wr, const float* wi, int n, int span) noexcept
+    {
+        if( span < 8 )
+            return butterflies(re, im, wr, wi, n, span);
+
+        for( int group = 0; group < n; group += 2 * span )
+        {
+            auto* aRe = re + group;
+            auto* aIm = im + group;
+            auto* bRe = aRe + span;
+            auto* bIm = aIm + span;
+
+            for( int j = 0; j < span; j += 8 )
+            {
+                const auto wRe = _mm256_loadu_ps(wr + j);
+                const auto wIm = _mm256_loadu_ps(wi + j);
+                const auto xRe = _mm256_loadu_ps(bRe + j);
+                const auto xIm = _mm256_loadu_ps(bIm + j);
+                const auto yRe = _mm256_loadu_ps(aRe + j);
+                const auto yIm = _mm256_loadu_ps(aIm + j);
+
+                const auto tRe = _mm256_sub_ps(_mm256_mul_ps(wRe, xRe), _mm256_mul_ps(wIm, xIm));
+                const auto tIm = _mm256_add_ps(_mm256_mul_ps(wRe, xIm), _mm256_mul_ps(wIm, xRe));
+
+                _mm256_storeu_ps(bRe + j, _mm256_sub_ps(yRe, tRe));
+                _mm256_storeu_ps(bIm + j, _mm256_sub_ps(yIm, tIm));
+                _mm256_storeu_ps(aRe + j, _mm256_add_ps(yRe, tRe));
+                _mm256_storeu_ps(aIm + j, _mm256_add_ps(yIm, tIm));
+            }
+        }
+    }
+#endif
+
+#if REALFFT_HAS_NEON
+    void stageNEON(float* re, float* im, const float* wr, const float* wi, int n, int span) noexcept
+    {
+        if( span < 4 )
+            return butterflies(re, im, wr, wi, n, span);
+
+        for( int group = 0; group < n; group += 2 * span )
+        {
+            auto* aRe = re + group;
+            auto* aIm = im + group;
+            auto* bRe = aRe + span;
+            auto* bIm = aIm + span;
+
+            for( int j = 0; j < span; j += 4 )
+            {
+                const auto wRe = vld1q_f32(wr + j);
+                const auto wIm = vld1q_f32(wi + j);
+                const auto xRe = vld1q_f32(bRe + j);
+                const auto xIm = vld1q_f32(bIm + j);
+                const auto yRe = vld1q_f32(aRe + j);
+                const auto yIm = vld1q_f32(aIm + j);
+
+                const auto tRe = vmlsq_f32(vmulq_f32(wRe, xRe), wIm, xIm);
+                const auto tIm = vmlaq_f32(vmulq_f32(wRe, xIm), wIm, xRe);
+
+                vst1q_f32(bRe + j, vsubq_f32(yRe, tRe));
+                vst1q_f32(bIm + j, vsubq_f32(yIm, tIm));
+                vst1q_f32(aRe + j, vaddq_f32(yRe, tRe));
+                vst1q_f32(aIm + j, vaddq_f32(yIm, tIm));
+            }
+        }
+    }
+#endif
+}
+
+/*!
+ @brief Builds the bit reversal table and twiddle tables for the given order.
+ @param order log2 of the transform size.
+ @param k The butterfly implementation to use.
+ */
+RealFFT::RealFFT(int order, Kernel k) :
+size(1 << order),
+half(size / 2),
+kernel(k)
+{
+    jassert(order >= 2);
+    jassert(isSupported(kernel));
+
+    re.resize(static_cast<size_t>(half));
+    im.resize(static_cast<size_t>(half));
+
+    const auto halfOrder = order - 1;
+    bitReversed.resize(static_cast<size_t>(half));
+    for( int i = 0; i < half; ++i )
+    {
+        int reversed = 0;
+        for( int bit = 0; bit < halfOrder; ++bit )
+            reversed |= ((i >> bit) & 1) << (halfOrder - 1 - bit);
+
+        bitReversed[static_cast<size_t>(i)] = reversed;
+    }
+
+    const auto twoPi = juce::MathConstants<double>::twoPi;
+
+    // spans 1, 2, 4 ... half / 2 need 1 + 2 + 4 ... = half - 1 twiddles
+    stageTwiddleRe.resize(static_cast<size_t>(juce::jmax(1, half - 1)));
+    stageTwiddleIm.resize(stageTwiddleRe.size());
+    for( int span = 1; span < half; span *= 2 )
+    {
+        for( int j = 0; j < span; ++j )
+        {
+            const auto angle = -twoPi * j / (2.0 * span);
+            stageTwiddleRe[static_cast<size_t>(span - 1 + j)] = static_cast<float>(std::cos(angle));
+            stageTwiddleIm[static_cast<size_t>(span - 1 + j)] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    splitTwiddleRe.resize(static_cast<size_t>(half));
+    splitTwiddleIm.resize(static_cast<size_t>(half));
+    for( int i = 0; i < half; ++i )
+    {
+        const auto angle = -twoPi * i / double(size);
+        splitTwiddleRe[static_cast<size_t>(i)] = static_cast<float>(std::cos(angle));
+        splitTwiddleIm[static_cast<size_t>(i)] = static_cast<float>(std::sin(angle));
+    }
+
+    switch( kernel )
+    {
+#if REALFFT_HAS_SSE
+        case Kernel::SSE: stage = stageSSE; break;
+#endif
+#if REALFFT_HAS_AVX
+        case Kernel::AVX: stage = stageAVX; break;
+#endif
+#if REALFFT_HAS_NEON
+        case Kernel::NEON: stage = stageNEON; break;
+#endif
+        default: stage = stageScalar; break;
+    }
+}
+
+/*!
+ @brief Runs the radix-2 stages over re/im, which must already be in bit reversed order.
+ */
+void RealFFT::complexForward() noexcept
+{
+    int firstSpan = 1;
+    if( half >= 4 )
+    {
+        firstTwoStages(re.data(), im.data(), half);
+        firstSpan = 4;
+    }
+
+    for( int span = firstSpan; span < half; span *= 2 )
+    {
+        stage(re.data(), im.data(),
+              stageTwiddleRe.data() + span - 1,
+              stageTwiddleIm.data() + span - 1,
+              half, span);
+    }
+}
+
+/*!
+ @brief Inverse of complexForward() including the 1/half scaling, via ifft(x) = conj(fft(conj(x))) / n.
+ */
+void RealFFT::complexInverse() noexcept
+{
+    juce::FloatVectorOperations::negate(im.data(), im.data(), half);
+    complexForward();
+    juce::FloatVectorOperations::multiply(re.data(), 1.f / float(half), half);
+    juce::FloatVectorOperations::multiply(im.data(), -1.f / float(half), half);
+}
+
+/*!
+ @brief Computes bin k (0 <= k <= half) of the real spectrum from the packed complex spectrum Z.
+ With E and O the spectra of the even and odd samples:
+ E = (Z[k] + conj(Z[half - k])) / 2, O = -i (Z[k] - conj(Z[half - k])) / 2, X[k] = E + exp(-2 pi i k / size) O
+ */
+void RealFFT::getBin(int k, float& binRe, float& binIm) const noexcept
+{
+    if( k == 0 || k == half )
+    {
+        binRe = k == 0 ? re[0] + im[0] : re[0] - im[0];
+        binIm = 0.f;
+        return;
+    }
+
+    const auto a = re[static_cast<size_t>(k)];
+    const auto b = im[static_cast<size_t>(k)];
+    const auto c = re[static_cast<size_t>(half - k)];
+    const auto d = im[static_cast<size_t>(half - k)];
+
+    const auto eRe = 0.5f * (a + c);
+    const auto eIm = 0.5f * (b - d);
+    const auto oRe = 0.5f * (b + d);
+    const auto oIm = -0.5f * (a - c);
+
+    const auto wRe = splitTwiddleRe[static_cast<size_t>(k)];
+    const auto wIm = splitTwiddleIm[static_cast<size_t>(k)];
+
+    binRe = eRe + wRe * oRe - wIm * oIm;
+    binIm = eIm + wRe * oIm + wIm * oRe;
+}
+
+void RealFFT::forward(const float* input, float* output) noexcept
+{
+    for( int i = 0; i < half; ++i )
+    {
+        const auto dest = static_cast<size_t>(bitReversed[static_cast<size_t>(i)]);
+        re[dest] = input[2 * i];
+        im[dest] = input[2 * i + 1];
+    }
+
+    complexForward();
+
+    for( int k = 0; k <= half; ++k )
+        getBin(k, output[2 * k], output[2 * k + 1]);
+}
+
+void RealFFT::forwardMagnitudes(const float* input, float* output) noexcept
+{
+    for( int i = 0; i < half; ++i )
+    {
+        const auto dest = static_cast<size_t>(bitReversed[static_cast<size_t>(i)]);
+        re[dest] = input[2 * i];
+        im[dest] = input[2 * i + 1];
+    }
+
+    complexForward();
+
+    for( int k = 0; k <= half; ++k )
+    {
+        float binRe, binIm;
+        getBin(k, binRe, binIm);
+        output[k] = std::sqrt(binRe * binRe + binIm * binIm);
+    }
+}
+
+/*!
+ @brief Merges the real spectrum back into the packed complex spectrum, runs the inverse complex FFT and unpacks.
+ E = (X[k] + conj(X[half - k])) / 2, O = conj(exp(-2 pi i k / size)) (X[k] - conj(X[half - k])) / 2, Z[k] = E + i O
+ */
+void RealFFT::inverse(const float* input, float* output) noexcept
+{
+    for( int k = 0; k < half; ++k )
+    {
+        const auto a = input[2 * k];
+        const auto b = input[2 * k + 1];
+        const auto c = input[2 * (half - k)];
+        const auto d = input[2 * (half - k) + 1];
+
+        const auto eRe = 0.5f * (a + c);
+        const auto eIm = 0.5f * (b - d);
+        const auto diffRe = 0.5f * (a - c);
+        const auto diffIm = 0.5f * (b + d);
+
+        const auto wRe = splitTwiddleRe[static_cast<size_t>(k)];
+        const auto wIm = -splitTwiddleIm[static_cast<size_t>(k)];
+
+        const auto oRe = wRe * diffRe - wIm * diffIm;
+        const auto oIm = wRe * diffIm + wIm * diffRe;
+
+        const auto dest = static_cast<size_t>(bitReversed[static_cast<size_t>(k)]);
+        re[dest] = eRe - oIm;
+        im[dest] = eIm + oRe;
+    }
+
+    complexInverse();
+
+    for( int i = 0; i < half; ++i )
+    {
+        output[2 * i] = re[static_cast<size_t>(i)];
+        output[2 * i + 1] = im[static_cast<size_t>(i)];
+    }
+}
+
+RealFFT::Kernel RealFFT::getBestKernel()
+{
+    for( auto k : { Kernel::AVX, Kernel::NEON, Kernel::SSE } )
+    {
+        if( isSupported(k) )
+            return k;
+    }
+
+    return Kernel::Scalar;
+}
+
+bool RealFFT::isSupported(Kernel k)
+{
+    switch( k )
+    {
+        case Kernel::Scalar:
+            return true;
+        case Kernel::SSE:
+#if REALFFT_HAS_SSE
+            return juce::SystemStats::hasSSE2();
+#else
+            return false;
+#endif
+        case Kernel::AVX:
+#if REALFFT_HAS_AVX
+            return juce::SystemStats::hasAVX();
+#else
+            return false;
+#endif
+        case Kernel::NEON:
+#if REALFFT_HAS_NEON
+            return true;
+#else
+            return false;
+#endif
+    }
+
+    return false;
+}
+
+const char* RealFFT::getKernelName(Kernel k)
+{
+    switch( k )
+    {
+        case Kernel::Scalar: return "scalar";
+        case Kernel::SSE: return "SSE";
+        case Kernel::AVX: return "AVX";
+        case Kernel::NEON: return "NEON";
+    }
+
+    return "unknown";
+}
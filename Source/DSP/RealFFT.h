@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    RealFFT.h
+    Created: 19 Oct 2026 1:14:52pm
+    Author:  zack
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class RealFFT
+ @brief A self contained FFT for real input signals with SSE, AVX and NEON butterflies.
+ A real signal of size N is packed into a complex signal of size N/2 (even samples real, odd samples imaginary),
+ transformed with an iterative radix-2 FFT and then split back into the N/2 + 1 bins of the real spectrum. That
+ does half the work of running a complex transform on real data.
+
+ The complex FFT keeps real and imaginary parts in separate arrays and stores each stage's twiddles
+ contiguously, so every butterfly stage with at least one vector's worth of butterflies per group runs fully
+ in SIMD registers. Which kernel runs is decided once at construction from what the CPU reports at runtime.
+
+ Layouts match juce::dsp::FFT: spectra are size/2 + 1 interleaved (re, im) pairs.
+ Nothing is allocated after construction.
+ */
+struct RealFFT
+{
+    /*! @brief The butterfly implementation used for the complex FFT stages. */
+    enum class Kernel
+    {
+        Scalar,
+        SSE,
+        AVX,
+        NEON
+    };
+
+    /*!
+     @param order log2 of the transform size, at least 2.
+     @param kernel The butterfly implementation. Must be supported by this CPU, see isSupported().
+     */
+    RealFFT(int order, Kernel kernel = getBestKernel());
+
+    int getSize() const noexcept { return size; }
+    Kernel getKernel() const noexcept { return kernel; }
+
+    /*!
+     @brief Forward transform.
+     @param input size real samples.
+     @param output size/2 + 1 interleaved complex bins, i.e. size + 2 floats. May be the same array as input.
+     */
+    void forward(const float* input, float* output) noexcept;
+
+    /*!
+     @brief Forward transform that only keeps the bin magnitudes.
+     @param input size real samples.
+     @param output size/2 + 1 magnitudes. May be the same array as input.
+     */
+    void forwardMagnitudes(const float* input, float* output) noexcept;
+
+    /*!
+     @brief Inverse transform, scaled by 1/size so forward() followed by inverse() gives back the input.
+     @param input size/2 + 1 interleaved complex bins.
+     @param output size real samples. May be the same array as input.
+     */
+    void inverse(const float* input, float* output) noexcept;
+
+    /*! @brief The fastest kernel the CPU this is running on supports. */
+    static Kernel getBestKernel();
+    static bool isSupported(Kernel kernel);
+    static const char* getKernelName(Kernel kernel);
+private:
+    int size;
+    int half;
+    Kernel kernel;
+
+    using StageFunction = void (*)(float* re, float* im, const float* wr, const float* wi, int n, int span);
+    StageFunction stage { nullptr };
+
+    /*! split complex work buffer of half samples */
+    std::vector<float> re, im;
+    /*! the twiddles of the stage with span h live at index h - 1, so each stage reads them contiguously */
+    std::vector<float> stageTwiddleRe, stageTwiddleIm;
+    /*! exp(-2 pi i k / size) for k < half, used to split/merge the real spectrum */
+    std::vector<float> splitTwiddleRe, splitTwiddleIm;
+    std::vector<int> bitReversed;
+
+    void complexForward() noexcept;
+    void complexInverse() noexcept;
+    /*! splits the packed complex spectrum in re/im into bin k of the real spectrum */
+    void getBin(int k, float& binRe, float& binIm) const noexcept;
+};
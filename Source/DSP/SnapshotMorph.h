@@ -0,0 +1,147 @@
+/*
+ ==============================================================================
+
+ SnapshotMorph.h
+ Created: 19 Oct 2026 9:47:03pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "Params.h"
+#include "TripleBuffer.h"
+
+/*!
+ @class SnapshotMorph
+ @brief NumSlots full parameter snapshots the audio thread can switch between or morph across, without touching
+ the parameters themselves.
+ The message thread stores snapshots and sets the position, 0 is the first slot, NumSlots - 1 the last and
+ anything in between interpolates the two neighbouring slots. A slot nothing was stored in yet stands for the
+ current parameter values, so engaging the morph or jumping to such a slot leaves the sound alone. The slots reach the audio thread through a
+ TripleBuffer, the position and whether the morph is engaged through atomics, so neither side ever waits.
+ Once per block process() blends the values read from the parameters towards the morphed snapshot. The position
+ and the engagement both ramp over rampSeconds, so switching slots or engaging the morph glides instead of
+ jumping. Frequencies, times and other strictly positive ranges interpolate geometrically, everything else
+ linearly, and a Bool takes the value of whichever side it's nearer to. The processor fades the audio across
+ such a switch over the same ramp length, see CompressorBand::bypassRampSeconds and its band levels.
+ @tparam NumSlots The number of snapshots, 2 for A/B.
+ */
+template<size_t NumSlots>
+struct SnapshotMorph
+{
+    static_assert( NumSlots >= 2, "a morph needs two snapshots at least" );
+
+    using Values = Params::Values;
+
+    static constexpr double rampSeconds = 0.05;
+
+    /*!
+     @brief Replaces a snapshot. Message thread only.
+     */
+    void store(size_t slot, const Values& values)
+    {
+        jassert(slot < NumSlots);
+        stored.snapshots[slot] = values;
+        stored.isStored[slot] = true;
+        published.write(stored);
+    }
+
+    /*! @brief Whether store() was called for the slot yet. Message thread only. */
+    bool isStored(size_t slot) const { return stored.isStored[slot]; }
+
+    /*! @brief The stored snapshot, only meaningful once isStored(). Message thread only. */
+    const Values& getSnapshot(size_t slot) const { return stored.snapshots[slot]; }
+
+    void setEngaged(bool shouldBeEngaged) { engaged.store(shouldBeEngaged); }
+    bool isEngaged() const { return engaged.load(); }
+
+    /*! @param newPosition 0 to NumSlots - 1 */
+    void setPosition(float newPosition) { position.store(juce::jlimit(0.f, float(NumSlots - 1), newPosition)); }
+    float getPosition() const { return position.load(); }
+
+    /*!
+     @brief The snapshots morphed at the position that was set, as the audio thread will settle on them.
+     Message thread only.
+     @param live The current parameter values, which any empty slot stands for.
+     */
+    void getMorphedValues(const Values& live, Values& values) const
+    {
+        morph(stored, position.load(), live, values);
+    }
+
+    /*!
+     @brief Sets the ramp lengths and jumps to the current position and engagement. Audio thread, or while it's stopped.
+     */
+    void prepare(double sampleRate)
+    {
+        smoothedPosition.reset(sampleRate, rampSeconds);
+        smoothedPosition.setCurrentAndTargetValue(position.load());
+        smoothedEngagement.reset(sampleRate, rampSeconds);
+        smoothedEngagement.setCurrentAndTargetValue(engaged.load() ? 1.f : 0.f);
+    }
+
+    /*!
+     @brief Advances the ramps by one block and blends values, read from the parameters, towards the morphed
+     snapshots. Audio thread only, never blocks or allocates, and leaves values alone while disengaged.
+     */
+    void process(int numSamples, Values& values)
+    {
+        smoothedPosition.setTargetValue(position.load(std::memory_order_relaxed));
+        smoothedEngagement.setTargetValue(engaged.load(std::memory_order_relaxed) ? 1.f : 0.f);
+
+        const auto currentPosition = smoothedPosition.skip(numSamples);
+        const auto engagement = smoothedEngagement.skip(numSamples);
+
+        if( engagement <= 0.f )
+            return;
+
+        Values morphed;
+        morph(published.readLatest(), currentPosition, values, morphed);
+
+        for( size_t i = 0; i < Params::NumParams; ++i )
+            values[i] = interpolate(Params::Table[i], values[i], morphed[i], engagement);
+    }
+
+    /*!
+     @brief The value a fraction t of the way from a to b, for the parameter spec describes.
+     */
+    static float interpolate(const Params::Spec& spec, float a, float b, float t)
+    {
+        if( spec.type == Params::Type::Bool )
+            return t < 0.5f ? a : b;
+
+        if( spec.type == Params::Type::Float && spec.minimum > 0.f && a > 0.f && b > 0.f )
+            return a * std::pow(b / a, t);
+
+        return a + (b - a) * t;
+    }
+private:
+    struct Snapshots
+    {
+        std::array<Values, NumSlots> snapshots;
+        std::array<bool, NumSlots> isStored {};
+    };
+
+    static void morph(const Snapshots& slots, float at, const Values& live, Values& values)
+    {
+        const auto lower = juce::jmin(static_cast<size_t>(juce::jmax(0.f, at)), NumSlots - 2);
+        const auto t = juce::jlimit(0.f, 1.f, at - float(lower));
+
+        const auto& from = slots.isStored[lower] ? slots.snapshots[lower] : live;
+        const auto& to = slots.isStored[lower + 1] ? slots.snapshots[lower + 1] : live;
+
+        for( size_t i = 0; i < Params::NumParams; ++i )
+            values[i] = interpolate(Params::Table[i], from[i], to[i], t);
+    }
+
+    /*! the message thread's copy, published as a whole whenever a slot changes */
+    Snapshots stored {};
+    TripleBuffer<Snapshots> published;
+
+    std::atomic<float> position { 0.f };
+    std::atomic<bool> engaged { false };
+
+    juce::SmoothedValue<float> smoothedPosition, smoothedEngagement;
+};
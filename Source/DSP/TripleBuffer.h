@@ -0,0 +1,62 @@
+/*
+ ==============================================================================
+
+ TripleBuffer.h
+ Created: 19 Oct 2026 3:52:40pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class TripleBuffer
+ @brief Hands the latest value of a struct from one writer thread to one reader thread, lock free and without tearing.
+ The writer always fills a slot nobody else touches and then exchanges it with the shared middle slot, the reader
+ exchanges its slot with the middle one whenever a fresher value is waiting. Neither side ever waits for the other
+ and a value is always read as a whole, as it was written. Unlike a Fifo, values the reader was too slow to pick
+ up are simply overwritten, which is what meters want.
+ @tparam T A trivially copyable struct, copied into a slot by write().
+ Example usage:
+ @code
+ TripleBuffer<Levels> levels;
+ levels.write(newLevels);                   // audio thread, once per block
+ const auto& latest = levels.readLatest();  // GUI thread, once per frame
+ @endcode
+ */
+template<typename T>
+struct TripleBuffer
+{
+    static_assert( std::is_trivially_copyable_v<T>, "TripleBuffer copies its values, keep them trivially copyable" );
+
+    /*!
+     @brief Publishes a new value. Writer thread only.
+     */
+    void write(const T& value) noexcept
+    {
+        slots[static_cast<size_t>(writeIndex)] = value;
+        writeIndex = middle.exchange(writeIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /*!
+     @brief The most recently published value. Reader thread only.
+     The reference stays valid and unchanged until the next call.
+     */
+    const T& readLatest() noexcept
+    {
+        if( (middle.load(std::memory_order_relaxed) & freshFlag) != 0 )
+            readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+
+        return slots[static_cast<size_t>(readIndex)];
+    }
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    std::array<T, 3> slots {};
+    int writeIndex { 0 };
+    std::atomic<int> middle { 1 };
+    int readIndex { 2 };
+};
@@ -12,9 +12,23 @@
 #include <JuceHeader.h>
 #include "../DSP/Fifo.h"
 #include "Utils.h"
+#include "FastMath.h"
+
+/*!
+ @brief How the bins that land on the same pixel column are combined.
+ */
+enum class BinAggregation
+{
+    Max,            //!< the loudest bin, keeps narrow peaks visible
+    PowerAverage    //!< the mean power of the bins, closer to what a band-limited meter would read
+};
 
 /*!
  @brief A helper class that generates a juce::Path from an array of float data
+ On a log frequency axis thousands of high bins collapse onto a handful of pixels, so the bins are grouped per pixel
+ column once, in a table that is only rebuilt when the bounds, fftSize or sample rate change. Each frame then emits
+ at most one point per column, aggregated from that column's bins. generateMultiResolutionPath() does the same for
+ two spectra of different resolution, each covering its own part of the frequency range.
  This class uses a Fifo to store the generated paths. The user can get the number of paths available and retrieve a path.
  */
  template<typename PathType>
@@ -34,15 +48,179 @@
                       float binWidth,
                       float negativeInfinity)
     {
-        auto top = fftBounds.getY();
-        auto bottom = fftBounds.getBottom();
-        //        auto bottom = fftBounds.getHeight();
-        auto width = fftBounds.getWidth();
+        fullRange.update(fftBounds.getWidth(), fftSize, binWidth, MIN_FREQUENCY, MAX_FREQUENCY);
+        
+        if( fullRange.columns.empty() )
+            return;
+        
+        // build the path straight into the fifo slot. clear() keeps the slot's storage around
+        auto slot = pathFifo.write();
+        if( ! slot )
+            return;
+        
+        PathType& p = *slot;
+        p.clear();
+        p.preallocateSpace(3 * static_cast<int>(fullRange.columns.size()));
+        
+        bool started = false;
+        appendColumns(p, started, fullRange, renderData, fftBounds, negativeInfinity);
+    }
+    
+    /*!
+     Stitches two spectra of different resolution into one path: the columns below crossoverFrequency come from
+     lowData, the ones above from highData.
+     @param lowData A fine resolution spectrum, typically from decimated audio, so only valid at low frequencies.
+     @param lowBinWidth The bin width of lowData.
+     @param highData A spectrum covering the whole audio range.
+     @param highBinWidth The bin width of highData.
+     @param crossoverFrequency Where the path switches from lowData to highData.
+     @param fftBounds The bounds of the FFT
+     @param fftSize The size of both FFTs
+     @param negativeInfinity The negative infinity value
+     */
+    void generateMultiResolutionPath(const std::vector<float>& lowData,
+                                     float lowBinWidth,
+                                     const std::vector<float>& highData,
+                                     float highBinWidth,
+                                     float crossoverFrequency,
+                                     juce::Rectangle<float> fftBounds,
+                                     int fftSize,
+                                     float negativeInfinity)
+    {
+        const auto width = fftBounds.getWidth();
+        lowRange.update(width, fftSize, lowBinWidth, MIN_FREQUENCY, crossoverFrequency);
+        highRange.update(width, fftSize, highBinWidth, crossoverFrequency, MAX_FREQUENCY);
+        
+        if( lowRange.columns.empty() && highRange.columns.empty() )
+            return;
+        
+        auto slot = pathFifo.write();
+        if( ! slot )
+            return;
         
-        int numBins = (int)fftSize / 2;
+        PathType& p = *slot;
+        p.clear();
+        p.preallocateSpace(3 * static_cast<int>(lowRange.columns.size() + highRange.columns.size()));
+        
+        bool started = false;
+        appendColumns(p, started, lowRange, lowData, fftBounds, negativeInfinity);
+        appendColumns(p, started, highRange, highData, fftBounds, negativeInfinity);
+    }
+    
+    void setAggregation(BinAggregation newAggregation) { aggregation = newAggregation; }
+    
+    int getNumPathsAvailable() const
+    {
+        return pathFifo.getNumAvailableForReading();
+    }
+    
+    bool getPath(PathType& path)
+    {
+        return pathFifo.pull(path);
+    }
+    
+    /*! @brief In-place access to the oldest path, see Fifo::read(). */
+    typename Fifo<PathType>::ReadHandle readPath()
+    {
+        return pathFifo.read();
+    }
+private:
+    Fifo<PathType> pathFifo;
+    
+    /*! the bins [firstBin, endBin) that are drawn at pixel column x */
+    struct Column
+    {
+        float x;
+        int firstBin;
+        int endBin;
+    };
+    
+    /*!
+     @brief The columns of the bins between two frequencies, cached for one width, fftSize and bin width.
+     */
+    struct ColumnTable
+    {
+        std::vector<Column> columns;
         
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
+        /*!
+         @brief Rebuilds the table if anything it depends on changed.
+         When the range starts at MIN_FREQUENCY, the bins below it (including DC) are folded into column 0, and when
+         it ends at MAX_FREQUENCY the bins above it go into the last column. Other bins outside the range are skipped.
+         */
+        void update(float width, int fftSize, float binWidth, float lowFrequency, float highFrequency)
+        {
+            const auto pixelWidth = static_cast<int>(width);
+            if( pixelWidth == cachedWidth && fftSize == cachedFFTSize && binWidth == cachedBinWidth
+               && lowFrequency == cachedLow && highFrequency == cachedHigh )
+                return;
+            
+            cachedWidth = pixelWidth;
+            cachedFFTSize = fftSize;
+            cachedBinWidth = binWidth;
+            cachedLow = lowFrequency;
+            cachedHigh = highFrequency;
+            
+            columns.clear();
+            if( pixelWidth <= 0 || fftSize <= 0 || binWidth <= 0.f )
+                return;
+            
+            const int numBins = fftSize / 2;
+            columns.reserve(static_cast<size_t>(juce::jmin(numBins, pixelWidth + 1)));
+            
+            const bool foldBelow = lowFrequency <= MIN_FREQUENCY;
+            const bool foldAbove = highFrequency >= MAX_FREQUENCY;
+            
+            int currentX = -1;
+            for( int binNum = 0; binNum < numBins; ++binNum )
+            {
+                auto binFreq = binNum * binWidth;
+                
+                if( binFreq < lowFrequency && ! foldBelow )
+                    continue;
+                if( binFreq >= highFrequency && ! foldAbove )
+                    break;
+                
+                binFreq = juce::jlimit(MIN_FREQUENCY, MAX_FREQUENCY, binFreq);
+                const auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY, MAX_FREQUENCY);
+                const auto binX = static_cast<int>(std::floor(normalizedBinX * pixelWidth));
+                
+                if( binX != currentX )
+                {
+                    columns.push_back({ static_cast<float>(binX), binNum, binNum + 1 });
+                    currentX = binX;
+                }
+                else
+                {
+                    columns.back().endBin = binNum + 1;
+                }
+            }
+        }
+    private:
+        int cachedWidth { -1 };
+        int cachedFFTSize { -1 };
+        float cachedBinWidth { -1.f };
+        float cachedLow { -1.f };
+        float cachedHigh { -1.f };
+    };
+    
+    ColumnTable fullRange, lowRange, highRange;
+    
+    BinAggregation aggregation { BinAggregation::Max };
+    
+    /*!
+     @brief Appends one point per column of the table to the path.
+     @param started Whether the path already has a first point, updated by this call.
+     */
+    void appendColumns(PathType& p,
+                       bool& started,
+                       const ColumnTable& table,
+                       const std::vector<float>& renderData,
+                       juce::Rectangle<float> fftBounds,
+                       float negativeInfinity) const
+    {
+        const auto top = fftBounds.getY();
+        const auto bottom = fftBounds.getBottom();
+        const auto numBins = static_cast<int>(renderData.size());
         
         auto map = [bottom, top, negativeInfinity](float v)
         {
@@ -54,43 +232,46 @@
             
         };
         
-        auto y = map(renderData[0]);
-        
-        //        jassert( !std::isnan(y) && !std::isinf(y) );
-        if( std::isnan(y) || std::isinf(y) )
-            y = bottom;
-        
-        p.startNewSubPath(0, y);
-        
-        const int pathResolution = 2; //you can draw line-to's every 'pathResolution' pixels.
-        
-        for( int binNum = 1; binNum < numBins; binNum += pathResolution )
+        for( const auto& column : table.columns )
         {
-            y = map(renderData[binNum]);
+            if( column.endBin > numBins )
+                break;
+            
+            auto y = map(aggregate(renderData, column));
             
-            //            jassert( !std::isnan(y) && !std::isinf(y) );
+            if( std::isnan(y) || std::isinf(y) )
+                y = bottom;
             
-            if( !std::isnan(y) && !std::isinf(y) )
+            if( started )
             {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, 20.f, 20000.f);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
+                p.lineTo(column.x, y);
+            }
+            else
+            {
+                p.startNewSubPath(column.x, y);
+                started = true;
             }
         }
-        
-        pathFifo.push(p);
-    }
-     
-    int getNumPathsAvailable() const
-    {
-        return pathFifo.getNumAvailableForReading();
     }
     
-    bool getPath(PathType& path)
+    /*!
+     @brief Combines the decibel values of one column's bins according to the aggregation mode.
+     */
+    float aggregate(const std::vector<float>& renderData, const Column& column) const
     {
-        return pathFifo.pull(path);
+        const auto* first = renderData.data() + column.firstBin;
+        const auto* last = renderData.data() + column.endBin;
+        
+        if( aggregation == BinAggregation::Max || column.endBin - column.firstBin == 1 )
+            return *std::max_element(first, last);
+        
+        // dB -> power, average, back to dB. 10^(dB/10) = e^(dB * ln(10)/10)
+        constexpr float dbToPowerExponent = 0.230258509f;
+        float power = 0.f;
+        for( auto* bin = first; bin != last; ++bin )
+            power += std::exp(*bin * dbToPowerExponent);
+        
+        power /= float(column.endBin - column.firstBin);
+        return 0.5f * FastMath::gainToDecibels(juce::jmax(power, 1.0e-30f));
     }
-private:
-    Fifo<PathType> pathFifo;
 };
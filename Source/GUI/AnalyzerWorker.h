@@ -0,0 +1,24 @@
+/*
+ ==============================================================================
+
+ AnalyzerWorker.h
+ Created: 19 Oct 2026 5:34:11pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class AnalyzerWorker
+ @brief One background thread shared by every analyzer, for work that must not stall the message thread, like
+ building and freeing large FFT generators.
+ Get hold of it through a juce::SharedResourcePointer<AnalyzerWorker>, the thread lives as long as somebody does.
+ Jobs must not refer to the object that queued them, capture what they need by value or shared_ptr instead.
+ */
+struct AnalyzerWorker
+{
+    juce::ThreadPool pool { 1 };
+};
@@ -0,0 +1,105 @@
+/*
+ ==============================================================================
+
+ BandSpectra.cpp
+ Created: 19 Oct 2026 7:26:53pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "BandSpectra.h"
+#include "FastMath.h"
+
+BandSpectra::BandSpectra()
+{
+    const auto fftSize = 1 << order;
+
+    forwardFFT = FFTBackend::create(order);
+
+    windowTable.resize(static_cast<size_t>(fftSize));
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(windowTable.data(),
+                                                              static_cast<size_t>(fftSize),
+                                                              juce::dsp::WindowingFunction<float>::blackmanHarris,
+                                                              true);
+    juce::FloatVectorOperations::multiply(windowTable.data(), 1.f / float(fftSize / 2), fftSize);
+
+    fftData.assign(static_cast<size_t>(fftSize * 2), 0.f);
+
+    for( auto& band : bands )
+        band.history.assign(static_cast<size_t>(fftSize), 0.f);
+}
+
+void BandSpectra::reset()
+{
+    for( auto& band : bands )
+    {
+        std::fill(band.history.begin(), band.history.end(), 0.f);
+        band.trace.clear();
+    }
+
+    writePosition = 0;
+    hasNewAudio = false;
+}
+
+void BandSpectra::pushCapturedBuffer(const juce::AudioBuffer<float>& captured)
+{
+    const auto fftSize = static_cast<int>(windowTable.size());
+    const auto numChannels = juce::jmin(numBands, captured.getNumChannels());
+
+    // only the newest fftSize samples can ever be transformed
+    auto numSamples = captured.getNumSamples();
+    auto readOffset = juce::jmax(0, numSamples - fftSize);
+    numSamples -= readOffset;
+
+    if( numSamples == 0 )
+        return;
+
+    const auto firstPart = juce::jmin(numSamples, fftSize - writePosition);
+
+    for( int ch = 0; ch < numChannels; ++ch )
+    {
+        auto* history = bands[static_cast<size_t>(ch)].history.data();
+        const auto* source = captured.getReadPointer(ch, readOffset);
+
+        juce::FloatVectorOperations::copy(history + writePosition, source, firstPart);
+        juce::FloatVectorOperations::copy(history, source + firstPart, numSamples - firstPart);
+    }
+
+    writePosition = (writePosition + numSamples) % fftSize;
+    hasNewAudio = true;
+}
+
+bool BandSpectra::process(juce::Rectangle<float> fftBounds, double sampleRate, float negativeInfinity)
+{
+    if( ! hasNewAudio )
+        return false;
+
+    hasNewAudio = false;
+
+    using FVO = juce::FloatVectorOperations;
+    const auto fftSize = static_cast<int>(windowTable.size());
+    const auto numBins = fftSize / 2;
+    const auto binWidth = float(sampleRate / double(fftSize));
+    const auto numOldest = fftSize - writePosition;
+
+    for( auto& band : bands )
+    {
+        // unroll the ring while windowing: the oldest samples run from writePosition to the end
+        FVO::multiply(fftData.data(), band.history.data() + writePosition, windowTable.data(), numOldest);
+        FVO::multiply(fftData.data() + numOldest, band.history.data(), windowTable.data() + numOldest, writePosition);
+
+        forwardFFT->performFrequencyOnlyForwardTransform(fftData.data());
+        FastMath::magnitudesToDecibels(fftData.data(), numBins, negativeInfinity);
+
+        band.pathGenerator.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
+
+        while( band.pathGenerator.getNumPathsAvailable() > 0 )
+        {
+            if( auto path = band.pathGenerator.readPath() )
+                band.trace.swapWithPath(*path);
+        }
+    }
+
+    return true;
+}
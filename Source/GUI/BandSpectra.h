@@ -0,0 +1,65 @@
+/*
+ ==============================================================================
+
+ BandSpectra.h
+ Created: 19 Oct 2026 7:26:53pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "AnalyzerPathGenerator.h"
+#include "SpectrumTrace.h"
+#include "../DSP/FFTBackend.h"
+#include "../PluginProcessor.h"
+
+/*!
+ @class BandSpectra
+ @brief The output spectrum of every compressor band, for overlaying on the analyzer.
+ It is fed the processor's bandAnalyzerFifo, which holds one mono channel per band. All bands share one FFT plan,
+ one window table and one work buffer. Captured audio only goes into each band's ring of the latest fftSize
+ samples, and process() transforms each ring once, however many buffers arrived since the last call. That is the
+ latest-frame-only policy: the cost is one FFT per band per display frame.
+ */
+struct BandSpectra
+{
+    static constexpr int numBands = static_cast<int>(SimpleMBCompAudioProcessor::NumBands);
+
+    BandSpectra();
+
+    /*! @brief Appends one captured buffer to the band histories. Channel i is band i. */
+    void pushCapturedBuffer(const juce::AudioBuffer<float>& captured);
+
+    /*!
+     @brief Transforms every band once if new audio arrived, and updates the traces.
+     @return true if the traces changed.
+     */
+    bool process(juce::Rectangle<float> fftBounds, double sampleRate, float negativeInfinity);
+
+    const SpectrumTrace& getTrace(int band) const { return bands[static_cast<size_t>(band)].trace; }
+
+    /*! @brief Silences the histories, e.g. when the overlay is switched back on. */
+    void reset();
+private:
+    static constexpr FFTOrder order = FFTOrder::order2048;
+
+    std::unique_ptr<FFTBackend> forwardFFT;
+    /*! blackman-harris window premultiplied by 1 / numBins, as in FFTDataGenerator */
+    std::vector<float> windowTable;
+    /*! shared transform workspace, 2 * fftSize floats */
+    std::vector<float> fftData;
+
+    struct Band
+    {
+        /*! the latest fftSize samples, the oldest at writePosition */
+        std::vector<float> history;
+        AnalyzerPathGenerator<SpectrumTrace> pathGenerator;
+        SpectrumTrace trace;
+    };
+
+    std::array<Band, numBands> bands;
+    int writePosition { 0 };
+    bool hasNewAudio { false };
+};
@@ -14,32 +14,41 @@
 #include "Utils.h"
 
 /*!
- @brief Constructor for CompressorBandControls
- @param apv - audio processor value tree state reference
- Initializes attackSlider, releaseSlider, thresholdSlider, ratioSlider
- Adds and makes visible bypassButton, soloButton, muteButton, lowBand, midBand, highBand
- Adds a listener to bypassButton, soloButton, muteButton
- Sets colors for bypassButton, soloButton, muteButton, lowBand, midBand, highBand
- Sets radio group id for lowBand, midBand, highBand
- Adds a button switcher for lowBand, midBand, highBand
- Sets toggle state for lowBand, triggers the updateAttachments method
+ @brief Builds the controls of one band and attaches them to its parameters.
+ The parameters for each control are obtained with Params::get, an O(1) typed lookup, and the changeParam
+ method is called on the corresponding control to set its parameter and labels. The makeAttachment helper
+ method is used to create the attachments. This is the only place the band's parameters are looked up.
+ @param apvts - audio processor value tree state reference
+ @param band - 0 for low, 1 for mid, 2 for high
  */
-CompressorBandControls::CompressorBandControls(juce::AudioProcessorValueTreeState& apv) : apvts(apv),
+CompressorBandControls::BandControls::BandControls(juce::AudioProcessorValueTreeState& apvts, size_t band) :
 attackSlider(nullptr, "ms", "ATTACK"),
 releaseSlider(nullptr, "ms", "RELEASE"),
 thresholdSlider(nullptr, "dB", "THRESH"),
 ratioSlider(nullptr, "")
 {
+    using namespace Params;
+    
+    auto& attackParam = get<juce::AudioParameterFloat>(apvts, forBand(BandParam::Attack, band));
+    addLabelPairs(attackSlider.labels, attackParam, "ms");
+    attackSlider.changeParam(&attackParam);
     
-    addAndMakeVisible(attackSlider);
-    addAndMakeVisible(releaseSlider);
-    addAndMakeVisible(thresholdSlider);
-    addAndMakeVisible(ratioSlider);
+    auto& releaseParam = get<juce::AudioParameterFloat>(apvts, forBand(BandParam::Release, band));
+    addLabelPairs(releaseSlider.labels, releaseParam, "ms");
+    releaseSlider.changeParam(&releaseParam);
     
-    // For changing colors of low, mid, high based on mute, solo, bypass
-    bypassButton.addListener(this);
-    soloButton.addListener(this);
-    muteButton.addListener(this);
+    auto& thresholdParam = get<juce::AudioParameterFloat>(apvts, forBand(BandParam::Threshold, band));
+    addLabelPairs(thresholdSlider.labels, thresholdParam, "dB");
+    thresholdSlider.changeParam(&thresholdParam);
+    
+    auto* ratioParam = &get<juce::AudioParameterChoice>(apvts, forBand(BandParam::Ratio, band));
+    
+    ratioSlider.labels.clear();
+    int choicesEndIndex = ratioParam->choices.size() - 1;
+    int finalRatioValue = ratioParam->choices.getReference(choicesEndIndex).getIntValue();
+    juce::String endRatioLabel = juce::String(finalRatioValue) + ":1";
+    ratioSlider.labels.add({1.0f, endRatioLabel});
+    ratioSlider.changeParam(ratioParam);
     
     using namespace juce::Colours;
     
@@ -55,64 +64,100 @@ ratioSlider(nullptr, "")
     muteButton.setColour(ButtonOnColorId, red);
     muteButton.setColour(ButtonOffColorId, black);
     
-    addAndMakeVisible(bypassButton);
-    addAndMakeVisible(soloButton);
-    addAndMakeVisible(muteButton);
-    
-    lowBand.setName("Low");
-    lowBand.setColour(ButtonOnColorId, grey);
-    lowBand.setColour(ButtonOffColorId, black);
-    
-    midBand.setName("Mid");
-    midBand.setColour(ButtonOnColorId, grey);
-    midBand.setColour(ButtonOffColorId, black);
-    
-    highBand.setName("High");
-    highBand.setColour(ButtonOnColorId, grey);
-    highBand.setColour(ButtonOffColorId, black);
+    makeAttachment(attackSliderAttachment, attackParam, attackSlider);
+    makeAttachment(releaseSliderAttachment, releaseParam, releaseSlider);
+    makeAttachment(thresholdSliderAttachment, thresholdParam, thresholdSlider);
+    makeAttachment(ratioSliderAttachment, *ratioParam, ratioSlider);
+    makeAttachment(bypassButtonAttachment, get<juce::AudioParameterBool>(apvts, forBand(BandParam::Bypassed, band)), bypassButton);
+    makeAttachment(soloButtonAttachment, get<juce::AudioParameterBool>(apvts, forBand(BandParam::Solo, band)), soloButton);
+    makeAttachment(muteButtonAttachment, get<juce::AudioParameterBool>(apvts, forBand(BandParam::Mute, band)), muteButton);
+}
+
+std::array<juce::Component*, 7> CompressorBandControls::BandControls::getComponents()
+{
+    return
+    {
+        &attackSlider, &releaseSlider, &thresholdSlider, &ratioSlider,
+        &bypassButton, &soloButton, &muteButton
+    };
+}
+
+/*!
+ @brief Constructor for CompressorBandControls
+ @param apv - audio processor value tree state reference
+ Builds and attaches the controls of every band, only the low band's are visible at first
+ Adds a listener to every band's bypassButton, soloButton, muteButton
+ Names, colors and groups one select button per band, and adds a button switcher to each
+ Sets toggle state for the low band's select button, triggers the updateVisibleBand method
+ */
+CompressorBandControls::CompressorBandControls(juce::AudioProcessorValueTreeState& apv) : apvts(apv)
+{
+    for( size_t i = 0; i < NumBands; ++i )
+    {
+        bands[i] = std::make_unique<BandControls>(apvts, i);
+        auto& band = *bands[i];
+        
+        for( auto* comp : band.getComponents() )
+            addChildComponent(comp);
+        
+        // For changing colors of low, mid, high based on mute, solo, bypass
+        band.bypassButton.addListener(this);
+        band.soloButton.addListener(this);
+        band.muteButton.addListener(this);
+        
+        updateSliderEnabledMents(band);
+    }
     
-    lowBand.setRadioGroupId(1);
-    midBand.setRadioGroupId(1);
-    highBand.setRadioGroupId(1);
+    using namespace juce::Colours;
     
     // Switching global band =====================
     auto buttonSwitcher = [safePtr = this->safePtr]()
     {
         if(auto* c = safePtr.getComponent())
         {
-            c->updateAttachments();
+            c->updateVisibleBand();
         }
     };
     
-    lowBand.onClick = buttonSwitcher;
-    midBand.onClick = buttonSwitcher;
-    highBand.onClick = buttonSwitcher;
+    for( size_t i = 0; i < NumBands; ++i )
+    {
+        auto& selectButton = bandSelectButtons[i];
+        selectButton.setName(Params::BandNames[i]);
+        selectButton.setColour(ButtonOnColorId, grey);
+        selectButton.setColour(ButtonOffColorId, black);
+        selectButton.setRadioGroupId(1);
+        selectButton.onClick = buttonSwitcher;
+    }
     
     // NOTE: we don't want to trigger the onClick = lambda yet, so we use "donSendNotification"
-    lowBand.setToggleState(true, juce::NotificationType::dontSendNotification);
-    updateAttachments();
+    bandSelectButtons.front().setToggleState(true, juce::NotificationType::dontSendNotification);
+    updateVisibleBand();
+    updateBandSelectButtonStates();
     // ===========================================
     
-    addAndMakeVisible(lowBand);
-    addAndMakeVisible(midBand);
-    addAndMakeVisible(highBand);
+    for( auto& selectButton : bandSelectButtons )
+        addAndMakeVisible(selectButton);
 }
 
 /*!
  @brief Destructor for CompressorBandControls
- Removes the listeners for bypassButton, soloButton, muteButton
+ Removes the listeners for every band's bypassButton, soloButton, muteButton
  */
 CompressorBandControls::~CompressorBandControls()
 {
-    bypassButton.removeListener(this);
-    soloButton.removeListener(this);
-    muteButton.removeListener(this);
-    
+    for( auto& band : bands )
+    {
+        band->bypassButton.removeListener(this);
+        band->soloButton.removeListener(this);
+        band->muteButton.removeListener(this);
+    }
 }
 
 /*!
  @brief Resizes the UI components of CompressorBandControls
  Calculates bounds and uses a flexbox to organize the components.
+ The band select column is laid out once, every band's controls then get the same bounds next to it, only one
+ set is visible at a time.
  */
 void CompressorBandControls::resized()
 {
@@ -137,38 +182,45 @@ void CompressorBandControls::resized()
         return flexBox;
     };
     
-    /*!
-     Pass vector of pointers to ui components, the lambda will organize them into a flexbox
-     */
-    auto bandButtonControlBox = createButtonControlBox({&bypassButton, &soloButton, &muteButton});
-    auto bandSelectControlBox = createButtonControlBox({&lowBand, &midBand, &highBand});
-    
-    FlexBox flexBox;
-    flexBox.flexDirection = FlexBox::Direction::row;
-    flexBox.flexWrap = FlexBox::Wrap::noWrap;
+    std::vector<Component*> selectButtons;
+    for( auto& selectButton : bandSelectButtons )
+        selectButtons.push_back(&selectButton);
     
-    auto spacer = FlexItem().withWidth(4);
-    //    auto endCap = FlexItem().withWidth(6);
+    auto bandSelectControlBox = createButtonControlBox(selectButtons);
+    bandSelectControlBox.performLayout(bounds.removeFromLeft(4 + 50).withTrimmedLeft(4));
     
-    /*!
-     What you are seeing here is in practice something like html or jsx.
-     the order we add these in is the order in which they are displayed
-     */
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(bandSelectControlBox).withWidth(50));
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(attackSlider).withFlex(1.f));
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(releaseSlider).withFlex(1.f));
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(thresholdSlider).withFlex(1.f));
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(ratioSlider).withFlex(1.f));
-    //    flexBox.items.add(endCap);
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(bandButtonControlBox).withWidth(30));
-    
-    flexBox.performLayout(bounds);
+    for( auto& band : bands )
+    {
+        /*!
+         Pass vector of pointers to ui components, the lambda will organize them into a flexbox
+         */
+        auto bandButtonControlBox = createButtonControlBox({&band->bypassButton, &band->soloButton, &band->muteButton});
+        
+        FlexBox flexBox;
+        flexBox.flexDirection = FlexBox::Direction::row;
+        flexBox.flexWrap = FlexBox::Wrap::noWrap;
+        
+        auto spacer = FlexItem().withWidth(4);
+        //    auto endCap = FlexItem().withWidth(6);
+        
+        /*!
+         What you are seeing here is in practice something like html or jsx.
+         the order we add these in is the order in which they are displayed
+         */
+        flexBox.items.add(spacer);
+        flexBox.items.add(FlexItem(band->attackSlider).withFlex(1.f));
+        flexBox.items.add(spacer);
+        flexBox.items.add(FlexItem(band->releaseSlider).withFlex(1.f));
+        flexBox.items.add(spacer);
+        flexBox.items.add(FlexItem(band->thresholdSlider).withFlex(1.f));
+        flexBox.items.add(spacer);
+        flexBox.items.add(FlexItem(band->ratioSlider).withFlex(1.f));
+        //    flexBox.items.add(endCap);
+        flexBox.items.add(spacer);
+        flexBox.items.add(FlexItem(bandButtonControlBox).withWidth(30));
+        
+        flexBox.performLayout(bounds);
+    }
 }
 
 
@@ -198,144 +250,136 @@ void CompressorBandControls::refreshBandButtonColors(juce::Button& band, juce::B
 }
 
 /*!
- @brief Resets the color of the active band
- Sets the color of the active band back to grey
- Repaints the active band
- */
-void CompressorBandControls::resetActiveBandColors()
-{
-    activeBand->setColour(ButtonOnColorId, juce::Colours::grey);
-    activeBand->setColour(ButtonOffColorId, juce::Colours::grey);
-    activeBand->repaint();
-}
-
-/*!
- @brief Updates the states of the band select buttons based on the values of their respective parameters
- Gets the necessary parameters and uses them to determine the states of the lowBand, midBand, highBand buttons.
+ @brief Updates the states of the band select buttons based on the states of their band's buttons
  If a band is soloed, its button color is set to the color of the solo button.
  If a band is muted, its button color is set to the color of the mute button.
  If a band is bypassed, its button color is set to the color of the bypass button.
+ The buttons follow their parameters through the attachments, so no parameter has to be looked up.
  */
 void CompressorBandControls::updateBandSelectButtonStates()
 {
-    using namespace Params;
-    std::vector<std::array<Names, 3>> paramsToCheck
+    for(size_t i = 0; i < NumBands; ++i)
     {
-        {Names::Solo_Low_Band, Names::Mute_Low_Band, Names::Bypassed_Low_Band},
-        {Names::Solo_Mid_Band, Names::Mute_Mid_Band, Names::Bypassed_Mid_Band},
-        {Names::Solo_High_Band, Names::Mute_High_Band, Names::Bypassed_High_Band},
-    };
-    
-    const auto& params = GetParams();
-    auto paramHelper = [&params, this](const auto& name)
-    {
-        return dynamic_cast<juce::AudioParameterBool*>(&getParam(apvts, params, name));
-    };
-    
-    for(size_t i = 0; i < paramsToCheck.size(); ++i)
-    {
-        auto& list = paramsToCheck[i];
+        auto& band = *bands[i];
+        auto* bandButton = &bandSelectButtons[i];
         
-        auto* bandButton = (i == 0) ? &lowBand :
-        (i == 1) ? &midBand :
-        &highBand;
-        
-        if( auto* solo = paramHelper(list[0]);
-           solo->get() )
+        if( band.soloButton.getToggleState() )
         {
-            refreshBandButtonColors(*bandButton, soloButton);
+            refreshBandButtonColors(*bandButton, band.soloButton);
         }
         
-        else if( auto* mute = paramHelper(list[1]);
-                mute->get() )
+        else if( band.muteButton.getToggleState() )
         {
-            refreshBandButtonColors(*bandButton, muteButton);
+            refreshBandButtonColors(*bandButton, band.muteButton);
         }
         
-        else if( auto* bypass = paramHelper(list[2]);
-                bypass->get() )
+        else if( band.bypassButton.getToggleState() )
         {
-            refreshBandButtonColors(*bandButton, bypassButton);
+            refreshBandButtonColors(*bandButton, band.bypassButton);
         }
-        
     }
 }
 
+size_t CompressorBandControls::findBandOf(const juce::Button& button) const
+{
+    for( size_t i = 0; i < NumBands; ++i )
+    {
+        const auto& band = *bands[i];
+        if( &button == &band.bypassButton || &button == &band.soloButton || &button == &band.muteButton )
+            return i;
+    }
+    
+    return NumBands;
+}
+
 /*!
  @fn CompressorBandControls::buttonClicked
  @brief Callback for when a button is clicked
  @param button - the button that was clicked
- Updates the enabled states of the sliders, the toggle states of the solo, mute, and bypass buttons, and the fill colors of the active band.
+ Updates the enabled states of the band's sliders, the toggle states of its solo, mute, and bypass buttons, and the fill colors of its band select button.
+ Hidden bands get here too, when their parameters are automated.
  */
 void CompressorBandControls::buttonClicked(juce::Button* button)
 {
-    updateSliderEnabledMents();
-    updateSoloMuteBypassToggleStates(*button);
-    updateActiveBandFillColors(*button);
+    const auto index = findBandOf(*button);
+    if( index == NumBands )
+        return;
+    
+    auto& band = *bands[index];
+    updateSliderEnabledMents(band);
+    updateSoloMuteBypassToggleStates(band, *button);
+    updateBandFillColors(index, *button);
 }
 
 void CompressorBandControls::toggleAllBands(bool shouldBeBypassed)
 {
-    std::vector<Component*> bands {&lowBand, &midBand, &highBand};
-    for(auto* band : bands)
+    // every band's bypass button has the same colours
+    auto& bypassButton = bands.front()->bypassButton;
+    
+    for( auto& selectButton : bandSelectButtons )
     {
-        band->setColour(juce::TextButton::ColourIds::buttonColourId,
-                            shouldBeBypassed ?
-                            bypassButton.findColour(juce::TextButton::ColourIds::buttonColourId) :
-                            juce::Colours::grey);
+        selectButton.setColour(juce::TextButton::ColourIds::buttonColourId,
+                               shouldBeBypassed ?
+                               bypassButton.findColour(juce::TextButton::ColourIds::buttonColourId) :
+                               juce::Colours::grey);
         
-        band->setColour(juce::TextButton::ColourIds::buttonColourId,
-                            shouldBeBypassed ?
-                            bypassButton.findColour(juce::TextButton::ColourIds::buttonColourId) :
-                            juce::Colours::black);
+        selectButton.setColour(juce::TextButton::ColourIds::buttonColourId,
+                               shouldBeBypassed ?
+                               bypassButton.findColour(juce::TextButton::ColourIds::buttonColourId) :
+                               juce::Colours::black);
         
-        band->repaint();
+        selectButton.repaint();
         
     }
     
 }
 
 /*!
- @brief Updates the colors of the active band button.
- This function updates the colors of the active band button based on the state of the clicked button. If the clicked button's toggle state is false, the colors of the active band are reset. Otherwise, the colors of the active band are refreshed based on the clicked button
+ @brief Updates the colors of a band's select button.
+ This function updates the colors of the band select button based on the state of the clicked button. If the clicked button's toggle state is false, the colors are reset to grey. Otherwise, the colors are refreshed based on the clicked button
  */
-void CompressorBandControls::updateActiveBandFillColors(juce::Button& clickedButton)
-
+void CompressorBandControls::updateBandFillColors(size_t band, juce::Button& clickedButton)
 {
-    jassert(activeBand != nullptr);
-    DBG("Active band: " << activeBand->getName());
+    auto* bandButton = &bandSelectButtons[band];
     
     if(clickedButton.getToggleState() == false)
     {
-        resetActiveBandColors();
+        bandButton->setColour(ButtonOnColorId, juce::Colours::grey);
+        bandButton->setColour(ButtonOffColorId, juce::Colours::grey);
+        bandButton->repaint();
     }
     else
     {
-        refreshBandButtonColors(*activeBand, clickedButton);
+        refreshBandButtonColors(*bandButton, clickedButton);
     }
 }
 
 
 /*!
- @brief Updates the enabled state of the sliders.
+ @brief Updates the enabled state of a band's sliders.
  This function updates the enabled state of the attack, release, threshold, and ratio sliders based on the state of the mute and bypass buttons. If either the mute or bypass button is selected, the sliders are disabled.
  */
-void CompressorBandControls::updateSliderEnabledMents()
+void CompressorBandControls::updateSliderEnabledMents(BandControls& band)
 {
-    auto disabled = muteButton.getToggleState() || bypassButton.getToggleState();
-    attackSlider.setEnabled(!disabled);
-    releaseSlider.setEnabled(!disabled);
-    thresholdSlider.setEnabled(!disabled);
-    ratioSlider.setEnabled(!disabled);
+    auto disabled = band.muteButton.getToggleState() || band.bypassButton.getToggleState();
+    band.attackSlider.setEnabled(!disabled);
+    band.releaseSlider.setEnabled(!disabled);
+    band.thresholdSlider.setEnabled(!disabled);
+    band.ratioSlider.setEnabled(!disabled);
 }
 
 /*!
- @brief Updates the toggle states of the solo, mute, and bypass buttons.
+ @brief Updates the toggle states of a band's solo, mute, and bypass buttons.
  This function updates the toggle states of the solo, mute, and bypass buttons based on which button was clicked. If the solo button was clicked and is selected, the mute and bypass buttons are disabled. If the mute button was clicked and is selected, the bypass and solo buttons are disabled. If the bypass button was clicked and is selected, the mute and solo buttons are disabled.
+ @param band The controls the clicked button belongs to.
  @param clickedButton The button that was clicked.
  */
-void CompressorBandControls::updateSoloMuteBypassToggleStates(juce::Button &clickedButton)
+void CompressorBandControls::updateSoloMuteBypassToggleStates(BandControls& band, juce::Button &clickedButton)
 {
+    auto& soloButton = band.soloButton;
+    auto& muteButton = band.muteButton;
+    auto& bypassButton = band.bypassButton;
+    
     // disable bypass and mute if solo selected
     if(&clickedButton == &soloButton && soloButton.getToggleState())
     {
@@ -359,165 +403,19 @@ void CompressorBandControls::updateSoloMuteBypassToggleStates(juce::Button &clic
 }
 
 /**
- 
- @brief Updates the attachments for the compressor band controls.
- This method updates the attachments for the different compressor band controls, such as the attack, release,
- threshold, ratio, mute, solo, and bypass controls. The specific band (low, mid, or high) is determined by
- checking the state of the toggle buttons for each band. The attachments are then reset and recreated for each
- control based on the band that is selected. The parameters for each control are obtained using the getParam
- helper method and the changeParam method is called on the corresponding control to update its parameter. The
- makeAttachment helper method is used to create the attachments for each control.
+ @brief Shows the controls of the selected band and hides the others.
+ Every band's controls were attached to their parameters in the constructor, so switching bands only flips
+ visibility: nothing is looked up, created or allocated, whatever the number of bands.
  */
-void CompressorBandControls::updateAttachments()
+void CompressorBandControls::updateVisibleBand()
 {
-    // Arbitrary band types
-    // TODO: are these necessary? Can't we do the switch case without them?
-    enum BandType
-    {
-        Low,
-        Mid,
-        High
-    };
-    // immediately invoked lambda, probably not necessary...
-    BandType bandType = [this]()
+    for( size_t i = 0; i < NumBands; ++i )
     {
-        if(lowBand.getToggleState())
-            return BandType::Low;
-        if(midBand.getToggleState())
-            return BandType::Mid;
+        const auto isSelected = bandSelectButtons[i].getToggleState();
+        if( isSelected )
+            activeBand = &bandSelectButtons[i];
         
-        return BandType::High;
-    }();
-    
-    using namespace Params;
-    std::vector<Names> names;
-    /*!
-     This is a little clunky. we are both getting the Names::thing and also using its index to
-     determine the name AND the parameter itself since params all over this plugin can be predicted
-     based on their order in which they exist in an array-like structure.
-     */
-    //    0 = attack
-    //    1 = relase
-    //    2 = threshold
-    //    3 = ratio
-    //    4 = mute
-    //    5 = solo
-    //    6 = bypass
-    switch(bandType)
-    {
-            
-        case Low:
-            names = std::vector<Names>
-            {
-                Names::Attack_Low_Band,
-                Names::Release_Low_Band,
-                Names::Threshold_Low_Band,
-                Names::Ratio_Low_Band,
-                Names::Mute_Low_Band,
-                Names::Solo_Low_Band,
-                Names::Bypassed_Low_Band
-            };
-            activeBand = &lowBand;
-            
-            break;
-        case Mid:
-            names = std::vector<Names>
-            {
-                Names::Attack_Mid_Band,
-                Names::Release_Mid_Band,
-                Names::Threshold_Mid_Band,
-                Names::Ratio_Mid_Band,
-                Names::Mute_Mid_Band,
-                Names::Solo_Mid_Band,
-                Names::Bypassed_Mid_Band
-            };
-            activeBand = &midBand;
-            
-            break;
-        case High:
-            names = std::vector<Names>
-            {
-                Names::Attack_High_Band,
-                Names::Release_High_Band,
-                Names::Threshold_High_Band,
-                Names::Ratio_High_Band,
-                Names::Mute_High_Band,
-                Names::Solo_High_Band,
-                Names::Bypassed_High_Band
-            };
-            activeBand = &highBand;
-            
-            break;
+        for( auto* comp : bands[i]->getComponents() )
+            comp->setVisible(isSelected);
     }
-    
-    enum Pos
-    {
-        Attack,
-        Release,
-        Threshold,
-        Ratio,
-        Mute,
-        Solo,
-        Bypass
-    };
-    
-    const auto& params = GetParams();
-    
-    auto getParameterHelper = [&params, &apvts = this->apvts, &names](const auto& pos) -> auto&
-    {
-        return getParam(apvts, params, names.at(pos));
-    };
-    
-    attackSliderAttachment.reset();
-    releaseSliderAttachment.reset();
-    thresholdSliderAttachment.reset();
-    ratioSliderAttachment.reset();
-    bypassButtonAttachment.reset();
-    soloButtonAttachment.reset();
-    muteButtonAttachment.reset();
-    
-    /*!
-     Call getParam and try to get Attack of whatever band (based on pos which is 0)
-     */
-    auto& attackParam = getParameterHelper(Pos::Attack);
-    addLabelPairs(attackSlider.labels, attackParam, "ms");
-    attackSlider.changeParam(&attackParam);
-    
-    auto& releaseParam = getParameterHelper(Pos::Release);
-    addLabelPairs(releaseSlider.labels, releaseParam, "ms");
-    releaseSlider.changeParam(&releaseParam);
-    
-    auto& thresholdParam = getParameterHelper(Pos::Threshold);
-    addLabelPairs(thresholdSlider.labels, thresholdParam, "dB");
-    thresholdSlider.changeParam(&thresholdParam);
-    
-    //    auto& ratioParam = getParameterHelper(Pos::Ratio);
-    //    addLabelPairs(ratioSlider.labels, &ratioParam, "?");
-    //    ratioSlider.changeParam(&ratioParam);
-    
-    auto& ratioParamRap = getParameterHelper(Pos::Ratio);
-    
-    ratioSlider.labels.clear();
-    auto ratioParam = dynamic_cast<juce::AudioParameterChoice*>(&ratioParamRap);
-    int choicesEndIndex = ratioParam->choices.size() - 1;
-    int finalRatioValue = ratioParam->choices.getReference(choicesEndIndex).getIntValue();
-    juce::String endRatioLabel = juce::String(finalRatioValue) + ":1";
-    ratioSlider.labels.add({1.0f, endRatioLabel});
-    ratioSlider.changeParam(ratioParam);
-    
-    // TODO: this has been duplicated >= 3 times
-    auto makeAttachmentHelper = [&params, &apvts = this->apvts](auto& attachment,
-                                                                const auto& name,
-                                                                auto& slider)
-    {
-        makeAttachment(attachment, apvts, params, name, slider);
-    };
-    
-    makeAttachmentHelper(attackSliderAttachment, names[Pos::Attack], attackSlider);
-    makeAttachmentHelper(releaseSliderAttachment, names[Pos::Release], releaseSlider);
-    makeAttachmentHelper(thresholdSliderAttachment, names[Pos::Threshold], thresholdSlider);
-    makeAttachmentHelper(ratioSliderAttachment, names[Pos::Ratio], ratioSlider);
-    makeAttachmentHelper(bypassButtonAttachment, names[Pos::Bypass], bypassButton);
-    makeAttachmentHelper(soloButtonAttachment, names[Pos::Solo], soloButton);
-    makeAttachmentHelper(muteButtonAttachment, names[Pos::Mute], muteButton);
 }
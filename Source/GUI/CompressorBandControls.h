@@ -11,9 +11,13 @@
 #pragma once
 #include <JuceHeader.h>
 #include "RotarySliderWithLabels.h"
+#include "../DSP/Params.h"
 
 /*!
  @brief UI Component for compressorband controls
+ Every band has its own set of sliders and buttons, attached to that band's parameters once in the constructor.
+ The Low/Mid/High selector only changes which set is visible, so switching bands creates no attachments, looks
+ up no parameters and allocates nothing. Hidden sets stay attached, so their buttons keep following automation.
  */
 struct CompressorBandControls : juce::Component, juce::Button::Listener
 {
@@ -28,35 +32,52 @@ private:
     static const juce::TextButton::ColourIds ButtonOffColorId { juce::TextButton::ColourIds::buttonColourId };
     juce::AudioProcessorValueTreeState&  apvts;
     
-    RotarySliderWithLabels attackSlider, releaseSlider, thresholdSlider;
-    RatioSlider ratioSlider;
+    static constexpr size_t NumBands = Params::NumBands;
     
-    using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    std::unique_ptr<Attachment> attackSliderAttachment,
-                                releaseSliderAttachment,
-                                thresholdSliderAttachment,
-                                ratioSliderAttachment;
+    /*!
+     @brief The controls of one band, attached to that band's parameters for as long as they exist.
+     */
+    struct BandControls
+    {
+        BandControls(juce::AudioProcessorValueTreeState& apvts, size_t band);
+        
+        RotarySliderWithLabels attackSlider, releaseSlider, thresholdSlider;
+        RatioSlider ratioSlider;
+        
+        using Attachment = juce::SliderParameterAttachment;
+        std::unique_ptr<Attachment> attackSliderAttachment,
+                                    releaseSliderAttachment,
+                                    thresholdSliderAttachment,
+                                    ratioSliderAttachment;
+        
+        juce::ToggleButton bypassButton, soloButton, muteButton;
+        
+        using BtnAttachment = juce::ButtonParameterAttachment;
+        std::unique_ptr<BtnAttachment> bypassButtonAttachment,
+                                       soloButtonAttachment,
+                                       muteButtonAttachment;
+        
+        std::array<juce::Component*, 7> getComponents();
+    };
     
-    juce::ToggleButton bypassButton, soloButton, muteButton, lowBand, midBand, highBand;
+    std::array<std::unique_ptr<BandControls>, NumBands> bands;
     
-    using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
-    std::unique_ptr<BtnAttachment> bypassButtonAttachment,
-                                   soloButtonAttachment,
-                                    muteButtonAttachment;
+    /*! one per band, named after Params::BandNames */
+    std::array<juce::ToggleButton, NumBands> bandSelectButtons;
     
     juce::Component::SafePointer<CompressorBandControls> safePtr {this};
     
     // NOTE: important
-    juce::ToggleButton* activeBand = {&lowBand};
+    juce::ToggleButton* activeBand = {&bandSelectButtons.front()};
     
-    void updateAttachments();
-    void updateSliderEnabledMents();
-    void updateSoloMuteBypassToggleStates(juce::Button& button);
-    void updateActiveBandFillColors(juce::Button& clickedButton);
-    void resetActiveBandColors();
+    /*! @brief Shows the controls of the band whose select button is on and hides the others. */
+    void updateVisibleBand();
+    /*! @return the index of the band whose solo, mute or bypass button this is, or NumBands if it's none of them */
+    size_t findBandOf(const juce::Button& button) const;
+    void updateSliderEnabledMents(BandControls& band);
+    void updateSoloMuteBypassToggleStates(BandControls& band, juce::Button& button);
+    void updateBandFillColors(size_t band, juce::Button& clickedButton);
     static void refreshBandButtonColors(juce::Button& band, juce::Button& colorSource);
-    // TODO: we are making this called in constructor to update band button colors
-    // independent of clicking
-    // 6:00:55
+    /*! @brief Colours every band select button after its band's solo, mute or bypass state. Called in the constructor. */
     void updateBandSelectButtonStates();
 };
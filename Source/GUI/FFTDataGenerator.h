@@ -11,7 +11,22 @@
 #pragma once
 #include <JuceHeader.h>
 #include "Utils.h"
+#include "FastMath.h"
+#include "OctaveSmoother.h"
 #include "../DSP/Fifo.h"
+#include "../DSP/FFTBackend.h"
+
+/*!
+ @brief How successive FFT frames are combined before they are displayed.
+ */
+enum class SpectrumAveraging
+{
+    Off,            //!< every frame as it comes
+    Exponential,    //!< a one pole average per bin, with separate rise and fall times
+    RMS,            //!< the root mean square of each bin over the last N frames
+    PeakHold,       //!< the largest value each bin has reached, until resetAveraging()
+    PeakDecay       //!< the largest value, falling back at a fixed rate in dB per second
+};
 
 /*!
  @brief This struct performs an FFT transformation on audio data, applies a windowing function, normalizes the FFT values, and converts the values to decibels. The resulting FFT data is stored in a FIFO buffer. The order of the FFT calculation can also be changed.
@@ -58,60 +73,55 @@
  |||||||||||||||||||||||||||||||||||||||||||||||||||||||||||
  |0        |10       |20       |30       |40       |50
  @endcode
+ 
+ The magnitudes can be averaged over time and smoothed across fractional octaves before the decibel conversion,
+ see SpectrumAveraging and OctaveSmoother. Every buffer the
+ averaging modes need is allocated by changeOrder(), so switching modes never allocates. Time constants are in
+ seconds and turned into per frame coefficients from the number of new samples each frame brings, so they don't
+ depend on how often frames are produced.
  */
 template<typename BlockType>
 struct FFTDataGenerator
 {
+    /*! the longest window RMS averaging supports, in frames */
+    static constexpr int maxRMSFrames = 32;
+    
     /**
      @brief This function produces FFT data for rendering purposes.
      The function takes in audio data as input and performs FFT transformation on it, after applying a windowing function and normalizing the FFT values. The values are then converted to decibels. The final FFT data is stored in the fftDataFifo member variable.
      @param audioData The input audio data on which FFT transformation is performed.
      @param negativeInfinity The negative infinity value used for converting the values to decibels.
+     @param numNewSamples How many samples of audioData are new since the previous frame, this sets the time step of the averaging.
      */
-    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity, int numNewSamples)
     {
         const auto fftSize = getFFTSize();
+        const auto numBins = fftSize / 2;
         
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
-        
-        /*! first apply a windowing function to our data */
-        window->multiplyWithWindowingTable (fftData.data(), fftSize);       // [1]
+        /*! copy and window in one pass. The table already holds the 1 / numBins normalisation, and the upper half
+         of fftData is only transform workspace, so it doesn't need zeroing. */
+        juce::FloatVectorOperations::multiply(fftData.data(),
+                                              audioData.getReadPointer(0),
+                                              windowTable.data(),
+                                              fftSize);
         
         /*! render the data */
-        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());  // [2]
+        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());
         
-        int numBins = (int)fftSize / 2;
+        /*! a non-finite bin would stay in the averages and the smoother for good, so clear it before either sees it */
+        FastMath::zeroNonFinite(fftData.data(), numBins);
         
-        //normalize the fft values.
-        for( int i = 0; i < numBins; ++i )
-        {
-            auto v = fftData[i];
-            //            fftData[i] /= (float) numBins;
-            if( !std::isinf(v) && !std::isnan(v) )
-            {
-                v /= float(numBins);
-            }
-            else
-            {
-                v = 0.f;
-            }
-            fftData[i] = v;
-        }
-        float max = negativeInfinity;
+        applyAveraging(numBins, float(numNewSamples / sampleRate));
+        smoother.process(fftData.data(), numBins);
         
-        //convert them to decibels
-        for( int i = 0; i < numBins; ++i )
+        /*! convert to decibels in a single vectorised pass */
+        FastMath::magnitudesToDecibels(fftData.data(), numBins, negativeInfinity);
+        
+        // every slot is prepared with fftData's size, so swapping hands the frame over without copying
+        if( auto slot = fftDataFifo.write() )
         {
-            auto data =  juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-            fftData[i] = data;
-            max = juce::jmax(data, max);
+            std::swap(*slot, fftData);
         }
-        
-//       jassertfalse;
-        
-        fftDataFifo.push(fftData);
     }
     
     
@@ -119,7 +129,7 @@ struct FFTDataGenerator
      @brief Changes the FFT order to the specified value
      This function changes the order of the FFT calculation and updates the relevant objects accordingly.
      The new FFT order is specified by the newOrder parameter.
-     The function also recreates the windowing function, forward FFT object, FFT data buffer, and the FFT data FIFO buffer.
+     The function also recreates the windowing table, forward FFT object, FFT data buffer, and the FFT data FIFO buffer.
      Additionally, the FIFO index is reset.
      @param newOrder New order of the FFT calculation example 2048
      */
@@ -132,24 +142,180 @@ struct FFTDataGenerator
         order = newOrder;
         auto fftSize = getFFTSize();
         
-        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
-        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
+        forwardFFT = FFTBackend::create(order);
+        
+        // the window is applied as a plain table multiply, with the per-bin normalisation folded in
+        windowTable.resize(static_cast<size_t>(fftSize));
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(windowTable.data(),
+                                                                  static_cast<size_t>(fftSize),
+                                                                  juce::dsp::WindowingFunction<float>::blackmanHarris,
+                                                                  true);
+        juce::FloatVectorOperations::multiply(windowTable.data(), 1.f / float(fftSize / 2), fftSize);
         
         fftData.clear();
         fftData.resize(fftSize * 2, 0);
         
         fftDataFifo.prepare(fftData.size());
+        
+        const auto numBins = static_cast<size_t>(fftSize / 2);
+        averaged.assign(numBins, 0.f);
+        rmsSum.assign(numBins, 0.f);
+        rmsHistory.assign(numBins * maxRMSFrames, 0.f);
+        resetAveraging();
+        
+        smoother.prepare(static_cast<int>(numBins));
+    }
+    
+    //==============================================================================
+    /*! @brief Selects the averaging mode and starts it from scratch. Never allocates. */
+    void setAveraging(SpectrumAveraging newAveraging)
+    {
+        averaging = newAveraging;
+        resetAveraging();
+    }
+    SpectrumAveraging getAveraging() const { return averaging; }
+    
+    /*!
+     @brief The time constants of SpectrumAveraging::Exponential.
+     @param riseSeconds How quickly a bin follows a louder signal.
+     @param fallSeconds How quickly a bin follows a quieter signal.
+     */
+    void setExponentialTimes(float riseSeconds, float fallSeconds)
+    {
+        riseTime = juce::jmax(0.f, riseSeconds);
+        fallTime = juce::jmax(0.f, fallSeconds);
+    }
+    
+    /*! @brief The window of SpectrumAveraging::RMS, clamped to [1, maxRMSFrames]. */
+    void setRMSFrames(int numFrames)
+    {
+        numRMSFrames = juce::jlimit(1, maxRMSFrames, numFrames);
+        resetAveraging();
+    }
+    
+    /*! @brief How fast SpectrumAveraging::PeakDecay falls back. */
+    void setPeakDecay(float decibelsPerSecond) { peakDecay = juce::jmax(0.f, decibelsPerSecond); }
+    
+    /*! @brief Fractional-octave smoothing applied after the time averaging, see OctaveSmoother. Never allocates. */
+    void setSmoothing(OctaveSmoothing smoothing) { smoother.setSmoothing(smoothing); }
+    
+    void setSampleRate(double newSampleRate) { if( newSampleRate > 0.0 ) sampleRate = newSampleRate; }
+    
+    /*! @brief Forgets every frame seen so far, e.g. to clear a held peak. */
+    void resetAveraging()
+    {
+        std::fill(averaged.begin(), averaged.end(), 0.f);
+        std::fill(rmsSum.begin(), rmsSum.end(), 0.f);
+        std::fill(rmsHistory.begin(), rmsHistory.end(), 0.f);
+        rmsIndex = 0;
+        hasAveragedFrame = false;
     }
     //==============================================================================
     int getFFTSize() const { return 1 << order; }
+    FFTOrder getOrder() const { return order; }
     int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
     //==============================================================================
     bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
+    /*! @brief In-place access to the oldest FFT frame, see Fifo::read(). */
+    typename Fifo<BlockType>::ReadHandle readFFTData() { return fftDataFifo.read(); }
 private:
     FFTOrder order;
     BlockType fftData;
-    std::unique_ptr<juce::dsp::FFT> forwardFFT;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    std::unique_ptr<FFTBackend> forwardFFT;
+    /*! blackman-harris window premultiplied by 1 / numBins */
+    std::vector<float> windowTable;
     
     Fifo<BlockType> fftDataFifo;
+    
+    SpectrumAveraging averaging { SpectrumAveraging::Off };
+    double sampleRate { 44100.0 };
+    float riseTime { 0.05f };
+    float fallTime { 0.5f };
+    float peakDecay { 12.f };
+    int numRMSFrames { 8 };
+    
+    /*! the averaged magnitudes, this is what gets displayed */
+    std::vector<float> averaged;
+    /*! maxRMSFrames frames of squared magnitudes and their running sum */
+    std::vector<float> rmsHistory, rmsSum;
+    int rmsIndex { 0 };
+    bool hasAveragedFrame { false };
+    
+    OctaveSmoother smoother;
+    
+    /*!
+     @brief Folds the magnitudes at the front of fftData into the running average and writes the result back.
+     @param numBins The number of magnitudes.
+     @param deltaTime The seconds of new audio this frame covers.
+     */
+    void applyAveraging(int numBins, float deltaTime)
+    {
+        using FVO = juce::FloatVectorOperations;
+        auto* magnitudes = fftData.data();
+        auto* average = averaged.data();
+        
+        switch( averaging )
+        {
+            case SpectrumAveraging::Off:
+                return;
+            case SpectrumAveraging::Exponential:
+            {
+                if( ! hasAveragedFrame )
+                {
+                    FVO::copy(average, magnitudes, numBins);
+                    break;
+                }
+                
+                auto coefficient = [deltaTime](float timeConstant)
+                {
+                    return timeConstant > 0.f ? 1.f - std::exp(-deltaTime / timeConstant) : 1.f;
+                };
+                
+                const auto rise = coefficient(riseTime);
+                const auto fall = coefficient(fallTime);
+                
+                // branch free so the compiler can vectorise it
+                for( int i = 0; i < numBins; ++i )
+                {
+                    const auto difference = magnitudes[i] - average[i];
+                    average[i] += (difference > 0.f ? rise : fall) * difference;
+                }
+                break;
+            }
+            case SpectrumAveraging::RMS:
+            {
+                auto* slot = rmsHistory.data() + static_cast<size_t>(rmsIndex) * static_cast<size_t>(numBins);
+                
+                // replace the oldest squared frame in the running sum
+                FVO::subtract(rmsSum.data(), slot, numBins);
+                FVO::multiply(slot, magnitudes, magnitudes, numBins);
+                FVO::add(rmsSum.data(), slot, numBins);
+                
+                rmsIndex = (rmsIndex + 1) % numRMSFrames;
+                
+                // re-add the window from scratch once per lap so float rounding can't accumulate
+                if( rmsIndex == 0 )
+                {
+                    FVO::copy(rmsSum.data(), rmsHistory.data(), numBins);
+                    for( int frame = 1; frame < numRMSFrames; ++frame )
+                        FVO::add(rmsSum.data(), rmsHistory.data() + static_cast<size_t>(frame) * static_cast<size_t>(numBins), numBins);
+                }
+                
+                const auto scale = 1.f / float(numRMSFrames);
+                for( int i = 0; i < numBins; ++i )
+                    average[i] = std::sqrt(juce::jmax(0.f, rmsSum[static_cast<size_t>(i)] * scale));
+                break;
+            }
+            case SpectrumAveraging::PeakHold:
+                FVO::max(average, average, magnitudes, numBins);
+                break;
+            case SpectrumAveraging::PeakDecay:
+                FVO::multiply(average, juce::Decibels::decibelsToGain(-peakDecay * deltaTime), numBins);
+                FVO::max(average, average, magnitudes, numBins);
+                break;
+        }
+        
+        hasAveragedFrame = true;
+        FVO::copy(magnitudes, average, numBins);
+    }
 };
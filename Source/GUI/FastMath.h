@@ -0,0 +1,92 @@
+/*
+ ==============================================================================
+ 
+ FastMath.h
+ Created: 19 Oct 2026 11:02:37am
+ Author:  zack
+ 
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+#include <cstring>
+
+/*!
+ @file FastMath.h
+ @brief Branch-free approximations for the analyzer's per-bin math.
+ Everything in here works on plain float arrays with no branches or library calls inside the loops, so the
+ compiler turns them into SIMD code. They trade a tiny, bounded error for speed and are meant for display only.
+ */
+namespace FastMath
+{
+    /*!
+     @brief Approximates 20 * log10(gain) for positive, normal gains.
+     The gain is split into its exponent and a mantissa in [1, 2); log2 of the mantissa comes from a 4th order
+     polynomial fitted over that interval. The error is below 0.001 dB for every normal float, which is far below
+     what a pixel on the analyzer can show.
+     @param gain A linear gain. Must be > 0 and not denormal, clamp it first.
+     @return The gain in decibels.
+     */
+    inline float gainToDecibels(float gain) noexcept
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &gain, sizeof(bits));
+        
+        const auto exponent = static_cast<float>(static_cast<int>((bits >> 23) & 0xffu) - 127);
+        
+        bits = (bits & 0x007fffffu) | 0x3f800000u; // same mantissa, exponent of 1.0
+        float mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+        
+        const auto x = mantissa - 1.f;
+        const auto log2Mantissa = x * (1.43901535f + x * (-0.67994987f + x * (0.32560854f + x * -0.08477672f)));
+        
+        // 20 * log10(2)
+        return 6.02059991f * (exponent + log2Mantissa);
+    }
+    
+    /*!
+     @brief A branch-free std::isfinite(), which also keeps working under -ffast-math.
+     */
+    inline bool isFinite(float v) noexcept
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        // an all-ones exponent means inf or NaN
+        return (bits & 0x7f800000u) != 0x7f800000u;
+    }
+    
+    /*!
+     @brief Converts FFT magnitudes to decibels in place.
+     NaN and infinite magnitudes become minusInfinityDb, everything else is floored at minusInfinityDb, which matches
+     juce::Decibels::gainToDecibels(v, minusInfinityDb) to within the error of gainToDecibels() above.
+     @param data The magnitudes, overwritten with decibel values.
+     @param numValues The number of values in data.
+     @param minusInfinityDb The decibel value that stands for silence.
+     */
+    inline void magnitudesToDecibels(float* data, int numValues, float minusInfinityDb) noexcept
+    {
+        const auto floorGain = std::pow(10.f, minusInfinityDb * 0.05f);
+        
+        for( int i = 0; i < numValues; ++i )
+        {
+            auto v = data[i];
+            v = isFinite(v) ? v : 0.f;
+            v = v > floorGain ? v : floorGain;
+            data[i] = gainToDecibels(v);
+        }
+    }
+    
+    /*!
+     @brief Replaces NaN and infinite values with 0, in place, so they can't poison anything that accumulates them.
+     @param data The values to clean up.
+     @param numValues The number of values in data.
+     */
+    inline void zeroNonFinite(float* data, int numValues) noexcept
+    {
+        for( int i = 0; i < numValues; ++i )
+            data[i] = isFinite(data[i]) ? data[i] : 0.f;
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ ==============================================================================
+
+ GainReductionLane.cpp
+ Created: 19 Oct 2026 8:02:17pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "GainReductionLane.h"
+#include "Utils.h"
+
+GainReductionLane::GainReductionLane(SimpleMBCompAudioProcessor& p) :
+audioProcessor(p)
+{
+    using namespace juce;
+    // the same colours the analyzer uses for the band spectra, low to high
+    bandColours[0] = Colour(64u, 160u, 255u).withAlpha(0.85f).getPixelARGB();
+    bandColours[1] = Colour(0u, 200u, 120u).withAlpha(0.85f).getPixelARGB();
+    bandColours[2] = Colour(255u, 110u, 90u).withAlpha(0.85f).getPixelARGB();
+
+    resetPending();
+    setOpaque(true);
+
+    // whatever queued up before the editor opened is stale
+    audioProcessor.getGainReductionHistory().drain([](const auto&) { });
+}
+
+juce::Rectangle<int> GainReductionLane::getHistoryArea() const
+{
+    // inside the border drawModuleBackground() draws
+    return getLocalBounds().reduced(6);
+}
+
+int GainReductionLane::getRow(float gainReductionDb) const
+{
+    const auto bottom = history.getHeight() - 1;
+    return juce::jlimit(0, bottom, juce::roundToInt(juce::jmap(gainReductionDb, 0.f, -rangeDb, 0.f, float(bottom))));
+}
+
+void GainReductionLane::resetPending()
+{
+    pendingMinDb.fill(0.f);
+    pendingMaxDb.fill(0.f);
+    pendingSamples = 0.0;
+    hasPending = false;
+}
+
+void GainReductionLane::resized()
+{
+    using namespace juce;
+    auto area = getHistoryArea();
+
+    if( area.isEmpty() )
+    {
+        history = Image();
+        return;
+    }
+
+    history = Image(Image::ARGB, area.getWidth(), area.getHeight(), false);
+    writeIndex = 0;
+    resetPending();
+
+    // a faint line every 6 dB
+    emptyColumn.assign(static_cast<size_t>(area.getHeight()), Colours::black.getPixelARGB());
+    for( auto db = 0.f; db >= -rangeDb; db -= 6.f )
+        emptyColumn[static_cast<size_t>(getRow(db))] = Colour(40u, 40u, 40u).getPixelARGB();
+
+    Image::BitmapData bitmap(history, Image::BitmapData::writeOnly);
+    for( int y = 0; y < bitmap.height; ++y )
+    {
+        for( int x = 0; x < bitmap.width; ++x )
+            *reinterpret_cast<PixelARGB*>(bitmap.getPixelPointer(x, y)) = emptyColumn[static_cast<size_t>(y)];
+    }
+}
+
+/*!
+ @brief Turns the pending min/max pairs into the column at writeIndex: each band is a span from its smallest to
+ its largest gain reduction, blended over the empty column so overlapping bands stay visible.
+ */
+void GainReductionLane::writeColumn()
+{
+    using namespace juce;
+    Image::BitmapData bitmap(history, writeIndex, 0, 1, history.getHeight(), Image::BitmapData::readWrite);
+
+    for( int y = 0; y < bitmap.height; ++y )
+        *reinterpret_cast<PixelARGB*>(bitmap.getPixelPointer(0, y)) = emptyColumn[static_cast<size_t>(y)];
+
+    if( hasPending )
+    {
+        for( size_t band = 0; band < numBands; ++band )
+        {
+            const auto top = getRow(pendingMaxDb[band]);
+            const auto bottom = getRow(pendingMinDb[band]);
+
+            for( int y = top; y <= bottom; ++y )
+                reinterpret_cast<PixelARGB*>(bitmap.getPixelPointer(0, y))->blend(bandColours[band]);
+        }
+    }
+
+    writeIndex = (writeIndex + 1) % history.getWidth();
+    hasNewColumns = true;
+}
+
+void GainReductionLane::refresh()
+{
+    using Block = SimpleMBCompAudioProcessor::GainReductionHistory::Block;
+    auto& ring = audioProcessor.getGainReductionHistory();
+    const auto sampleRate = audioProcessor.getSampleRate();
+
+    if( ! history.isValid() || sampleRate <= 0.0 )
+    {
+        ring.drain([](const Block&) { });
+        return;
+    }
+
+    const auto samplesPerColumn = sampleRate * historySeconds / history.getWidth();
+
+    ring.drain([this, samplesPerColumn](const Block& block)
+    {
+        for( size_t band = 0; band < numBands; ++band )
+        {
+            pendingMinDb[band] = hasPending ? juce::jmin(pendingMinDb[band], block.minDb[band]) : block.minDb[band];
+            pendingMaxDb[band] = hasPending ? juce::jmax(pendingMaxDb[band], block.maxDb[band]) : block.maxDb[band];
+        }
+
+        hasPending = true;
+        pendingSamples += block.numSamples;
+
+        if( pendingSamples < samplesPerColumn )
+            return;
+
+        // a block longer than a pixel fills several columns
+        while( pendingSamples >= samplesPerColumn )
+        {
+            writeColumn();
+            pendingSamples -= samplesPerColumn;
+        }
+
+        // what's left over belongs to this block alone
+        pendingMinDb = block.minDb;
+        pendingMaxDb = block.maxDb;
+        hasPending = pendingSamples > 0.0;
+    });
+
+    if( hasNewColumns )
+    {
+        hasNewColumns = false;
+        repaint(getHistoryArea());
+    }
+}
+
+void GainReductionLane::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    g.fillAll(Colours::black);
+    drawModuleBackground(g, getLocalBounds());
+
+    if( ! history.isValid() )
+        return;
+
+    const auto area = getHistoryArea();
+    const auto height = history.getHeight();
+    const auto numOldest = history.getWidth() - writeIndex;
+
+    // oldest columns on the left, newest on the right
+    g.drawImage(history, area.getX(), area.getY(), numOldest, height, writeIndex, 0, numOldest, height);
+
+    if( writeIndex > 0 )
+        g.drawImage(history, area.getX() + numOldest, area.getY(), writeIndex, height, 0, 0, writeIndex, height);
+
+    g.setColour(Colours::lightgrey);
+    g.setFont(10.f);
+    g.drawText("GR", area.reduced(2), Justification::topLeft);
+    g.drawText(String(-rangeDb, 0) + " dB", area.reduced(2), Justification::bottomLeft);
+}
@@ -0,0 +1,61 @@
+/*
+ ==============================================================================
+
+ GainReductionLane.h
+ Created: 19 Oct 2026 8:02:17pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*!
+ @class GainReductionLane
+ @brief A scrolling history of every band's gain reduction, so pumping can be judged over the last seconds
+ instead of from the current value alone. Time runs left to right, 0 dB is at the top.
+ The processor's GainReductionRing delivers one min/max pair per band per audio block. refresh() merges them
+ until they cover one pixel's worth of samples, and each pixel becomes one column of a ring-indexed image, the
+ same way the Spectrogram scrolls: a column costs O(height), the history is never redrawn, and paint() shows it
+ in time order with two blits.
+ */
+struct GainReductionLane : juce::Component
+{
+    GainReductionLane(SimpleMBCompAudioProcessor& p);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    /*! @brief Drains the processor's gain reduction ring and repaints if a column was written. */
+    void refresh();
+private:
+    SimpleMBCompAudioProcessor& audioProcessor;
+
+    static constexpr size_t numBands = SimpleMBCompAudioProcessor::NumBands;
+    /*! how much time the width of the lane shows */
+    static constexpr double historySeconds = 10.0;
+    /*! the gain reduction at the bottom of the lane */
+    static constexpr float rangeDb = 24.f;
+
+    juce::Image history;
+    /*! the column the next pixel goes to, everything right of it is older */
+    int writeIndex { 0 };
+    bool hasNewColumns { false };
+
+    /*! the blocks merged since the last column was written */
+    std::array<float, numBands> pendingMinDb, pendingMaxDb;
+    double pendingSamples { 0.0 };
+    bool hasPending { false };
+    void resetPending();
+
+    /*! background and grid lines of an empty column, copied in before the bands are drawn */
+    std::vector<juce::PixelARGB> emptyColumn;
+    std::array<juce::PixelARGB, numBands> bandColours;
+
+    void writeColumn();
+    int getRow(float gainReductionDb) const;
+
+    juce::Rectangle<int> getHistoryArea() const;
+};
@@ -24,43 +24,29 @@
 GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
 {
     using namespace Params;
-    const auto& params = GetParams();
     
-    auto getParameterHelper = [&params, &apvts](const auto& name) -> auto&
-    {
-        return getParam(apvts, params, name);
-    };
-    
-    
-    auto& gainInParam = getParameterHelper(Names::Gain_In);
-    auto& lowMidParam = getParameterHelper(Names::Low_Mid_Crossover_Freq);
-    auto& midHighParam = getParameterHelper(Names::Mid_High_Crossover_Freq);
-    auto& gainOutParam = getParameterHelper(Names::Gain_Out);
+    auto& gainInParam = get<juce::AudioParameterFloat>(apvts, Names::Gain_In);
+    auto& lowMidParam = get<juce::AudioParameterFloat>(apvts, Names::Low_Mid_Crossover_Freq);
+    auto& midHighParam = get<juce::AudioParameterFloat>(apvts, Names::Mid_High_Crossover_Freq);
+    auto& gainOutParam = get<juce::AudioParameterFloat>(apvts, Names::Gain_Out);
     
     inGainSlider = std::make_unique<RSWL>(&gainInParam, "dB", "INPUT TRIM");
     lowMidXoverSlider = std::make_unique<RSWL>(&lowMidParam, "Hz", "LOW-MID X-OVER");
     midHighXoverSlider = std::make_unique<RSWL>(&midHighParam, "Hz", "MID-HI X-OVER");
     outGainSlider = std::make_unique<RSWL>(&gainOutParam, "dB", "OUTPUT TRIM");
     
-    auto makeAttachmentHelper = [&params, &apvts](auto& attachment,
-                                                  const auto& name,
-                                                  auto& slider)
-    {
-        makeAttachment(attachment, apvts, params, name, slider);
-    };
-    
-    makeAttachmentHelper(inGainSliderAttachment,
-                         Names::Gain_In,
-                         *inGainSlider);
-    makeAttachmentHelper(lowMidXoverSliderAttachment,
-                         Names::Low_Mid_Crossover_Freq,
-                         *lowMidXoverSlider);
-    makeAttachmentHelper(midHighXoverSliderAttachment,
-                         Names::Mid_High_Crossover_Freq,
-                         *midHighXoverSlider);
-    makeAttachmentHelper(outGainSliderAttachment,
-                         Names::Gain_Out,
-                         *outGainSlider);
+    makeAttachment(inGainSliderAttachment,
+                   gainInParam,
+                   *inGainSlider);
+    makeAttachment(lowMidXoverSliderAttachment,
+                   lowMidParam,
+                   *lowMidXoverSlider);
+    makeAttachment(midHighXoverSliderAttachment,
+                   midHighParam,
+                   *midHighXoverSlider);
+    makeAttachment(outGainSliderAttachment,
+                   gainOutParam,
+                   *outGainSlider);
     
     addLabelPairs(inGainSlider->labels, gainInParam, "dB");
     
@@ -28,7 +28,7 @@ private:
     using RSWL = RotarySliderWithLabels;
     std::unique_ptr<RSWL> inGainSlider, lowMidXoverSlider, midHighXoverSlider, outGainSlider;
     
-    using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    using Attachment = juce::SliderParameterAttachment;
     
     std::unique_ptr<Attachment> lowMidXoverSliderAttachment,
     midHighXoverSliderAttachment,
@@ -69,13 +69,22 @@ void LookAndFeel::drawRotarySlider(juce::Graphics & g,
     
     auto enabled = slider.isEnabled();
     
-    /* set the fill color of the circle */
-    g.setColour(enabled ?  ColorScheme::getSliderFillColor() : Colours::grey);
-    /* fit a circle whose diameter is exactly the width of the rectangular bounds */
-    g.fillEllipse(bounds);
+    /* the filled and outlined circle comes from the cache, it only depends on the size and the colours */
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const auto& knobBody = getKnobBody(width,
+                                       height,
+                                       scale,
+                                       enabled ? ColorScheme::getSliderFillColor() : Colours::grey,
+                                       enabled ? ColorScheme::getSliderBorderColor() : Colours::grey);
+    
+    /* one image pixel per physical pixel, starting on a physical pixel, so the image is copied rather than
+     resampled and the outline stays as sharp as drawEllipse() would draw it */
+    auto snapToPhysicalPixel = [scale](float logical) { return std::round(logical * scale) / scale; };
+    g.drawImageTransformed(knobBody,
+                           AffineTransform::scale(1.f / scale)
+                               .translated(snapToPhysicalPixel(bounds.getX() - 1.f), snapToPhysicalPixel(bounds.getY() - 1.f)));
     
     g.setColour(enabled ? ColorScheme::getSliderBorderColor() : Colours::grey);
-    g.drawEllipse(bounds, 1.f);
     
     if( auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
     {
@@ -114,6 +123,51 @@ void LookAndFeel::drawRotarySlider(juce::Graphics & g,
     }
 }
 
+/*!
+ * @brief Finds or renders the knob body for the given size, display scale and colours.
+ *
+ * The image is rendered at the physical pixel scale so the outline stays crisp on high DPI screens.
+ * The colours are part of the key because they are live constants in debug builds.
+ */
+const juce::Image& LookAndFeel::getKnobBody(int width, int height, float scale, juce::Colour fill, juce::Colour border)
+{
+    using namespace juce;
+    
+    for( const auto& body : knobBodies )
+    {
+        if( body.width == width && body.height == height && body.scale == scale && body.fill == fill && body.border == border )
+            return body.image;
+    }
+    
+    if( knobBodies.size() >= maxKnobBodies )
+        knobBodies.erase(knobBodies.begin());
+    
+    KnobBody body;
+    body.width = width;
+    body.height = height;
+    body.scale = scale;
+    body.fill = fill;
+    body.border = border;
+    body.image = Image(Image::ARGB,
+                       jmax(1, roundToInt((width + 2) * scale)),
+                       jmax(1, roundToInt((height + 2) * scale)),
+                       true);
+    
+    Graphics g(body.image);
+    g.addTransform(AffineTransform::scale(scale));
+    
+    /* fit a circle whose diameter is exactly the width of the rectangular bounds */
+    auto bounds = Rectangle<float>(1.f, 1.f, float(width), float(height));
+    g.setColour(fill);
+    g.fillEllipse(bounds);
+    
+    g.setColour(border);
+    g.drawEllipse(bounds, 1.f);
+    
+    knobBodies.push_back(std::move(body));
+    return knobBodies.back().image;
+}
+
 /*!
  * @brief Draws the toggle button component.
  *
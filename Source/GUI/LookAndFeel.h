@@ -15,6 +15,8 @@
  @brief A struct that extends the juce::LookAndFeel_V4 class.
  This struct provides custom implementations of the drawRotarySlider() and drawToggleButton() methods,
  which are used to display rotary sliders and toggle buttons in the graphical user interface.
+ The knob body never changes while the knob turns, so drawRotarySlider() renders it once per size, display scale
+ and colour into an image and only draws the pointer and the value text on every repaint.
  */
 struct LookAndFeel : juce::LookAndFeel_V4
 {
@@ -29,4 +31,23 @@ struct LookAndFeel : juce::LookAndFeel_V4
                            juce::ToggleButton & toggleButton,
                            bool shouldDrawButtonAsHighlighted,
                            bool shouldDrawButtonAsDown) override;
+private:
+    /*!
+     A pre-rendered knob body, the filled and outlined ellipse. Knobs of the same size share one entry.
+     */
+    struct KnobBody
+    {
+        int width { 0 };
+        int height { 0 };
+        float scale { 0.f };
+        juce::Colour fill, border;
+        /*! one logical pixel larger than the knob on every side, for the outline */
+        juce::Image image;
+    };
+    
+    /*! only ever holds a handful of sizes, the oldest entries go first */
+    std::vector<KnobBody> knobBodies;
+    static constexpr size_t maxKnobBodies = 16;
+    
+    const juce::Image& getKnobBody(int width, int height, float scale, juce::Colour fill, juce::Colour border);
 };
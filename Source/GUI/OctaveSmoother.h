@@ -0,0 +1,125 @@
+/*
+ ==============================================================================
+
+ OctaveSmoother.h
+ Created: 19 Oct 2026 5:02:36pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @brief The width of the fractional-octave smoothing window.
+ */
+enum class OctaveSmoothing
+{
+    Off,
+    ThirdOctave,
+    SixthOctave,
+    TwelfthOctave
+};
+
+/*!
+ @class OctaveSmoother
+ @brief Replaces every bin with the power average of the bins within a fixed fraction of an octave around it.
+ The window of bin k runs from k * 2^(-1/2n) to k * 2^(1/2n) for 1/n octave smoothing, so it widens with
+ frequency. Those bin ranges are worked out once per FFT size and smoothing width, and each frame builds one
+ prefix sum of the bin powers, after which every window average is a single subtraction. A frame costs
+ O(numBins) however wide the windows get.
+ Because the windows are ratios of the bin's own frequency, the tables don't depend on the sample rate.
+ */
+struct OctaveSmoother
+{
+    /*!
+     @brief Sizes the tables for an FFT. Allocates, call it where the FFT itself is (re)built.
+     @param numBins The number of magnitudes process() will be given.
+     */
+    void prepare(int numBins)
+    {
+        const auto size = static_cast<size_t>(juce::jmax(0, numBins));
+        firstBin.assign(size, 0);
+        lastBin.assign(size, 0);
+        prefixSum.assign(size + 1, 0.0);
+        buildTables();
+    }
+
+    /*! @brief Selects the smoothing width. Rebuilds the tables in place, never allocates. */
+    void setSmoothing(OctaveSmoothing newSmoothing)
+    {
+        if( newSmoothing == smoothing )
+            return;
+
+        smoothing = newSmoothing;
+        buildTables();
+    }
+
+    OctaveSmoothing getSmoothing() const { return smoothing; }
+
+    /*!
+     @brief Smooths linear magnitudes in place.
+     @param magnitudes numBins magnitudes, as passed to prepare().
+     @param numBins The number of magnitudes.
+     */
+    void process(float* magnitudes, int numBins)
+    {
+        if( smoothing == OctaveSmoothing::Off )
+            return;
+
+        numBins = juce::jmin(numBins, static_cast<int>(firstBin.size()));
+
+        // double precision, a float running sum of 8k powers loses the quiet bins next to loud ones
+        prefixSum[0] = 0.0;
+        for( int i = 0; i < numBins; ++i )
+            prefixSum[static_cast<size_t>(i + 1)] = prefixSum[static_cast<size_t>(i)] + double(magnitudes[i]) * double(magnitudes[i]);
+
+        for( int i = 0; i < numBins; ++i )
+        {
+            const auto first = firstBin[static_cast<size_t>(i)];
+            const auto last = lastBin[static_cast<size_t>(i)];
+            const auto power = (prefixSum[static_cast<size_t>(last + 1)] - prefixSum[static_cast<size_t>(first)]) / double(last - first + 1);
+
+            magnitudes[i] = float(std::sqrt(juce::jmax(0.0, power)));
+        }
+    }
+private:
+    OctaveSmoothing smoothing { OctaveSmoothing::Off };
+
+    /*! bin i is smoothed over the bins [firstBin[i], lastBin[i]] */
+    std::vector<int> firstBin, lastBin;
+    std::vector<double> prefixSum;
+
+    static double getOctaveFraction(OctaveSmoothing s)
+    {
+        switch( s )
+        {
+            case OctaveSmoothing::ThirdOctave: return 3.0;
+            case OctaveSmoothing::SixthOctave: return 6.0;
+            case OctaveSmoothing::TwelfthOctave: return 12.0;
+            case OctaveSmoothing::Off: break;
+        }
+
+        return 0.0;
+    }
+
+    void buildTables()
+    {
+        const auto numBins = static_cast<int>(firstBin.size());
+        const auto fraction = getOctaveFraction(smoothing);
+
+        if( numBins == 0 || fraction == 0.0 )
+            return;
+
+        const auto lowerRatio = std::pow(2.0, -0.5 / fraction);
+        const auto upperRatio = std::pow(2.0, 0.5 / fraction);
+
+        for( int i = 0; i < numBins; ++i )
+        {
+            // every window holds at least its own bin
+            firstBin[static_cast<size_t>(i)] = juce::jlimit(0, i, static_cast<int>(std::ceil(i * lowerRatio)));
+            lastBin[static_cast<size_t>(i)] = juce::jlimit(i, numBins - 1, static_cast<int>(std::floor(i * upperRatio)));
+        }
+    }
+};
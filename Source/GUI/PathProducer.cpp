@@ -10,56 +10,331 @@
 
 #include "PathProducer.h"
 
+PathProducer::PathProducer(AnalyzerChannel view) :
+channelView(view)
+{
+    PendingGenerator initial;
+    initial.build(requestedOrder, false);
+    
+    leftChannelFFTDataGenerator = std::move(initial.generator);
+    monoBuffer = std::move(initial.monoBuffer);
+    lowFFTDataGenerator = std::move(initial.lowGenerator);
+    lowBuffer = std::move(initial.lowBuffer);
+}
+
+void PathProducer::setAveraging(SpectrumAveraging newAveraging)
+{
+    averaging = newAveraging;
+    leftChannelFFTDataGenerator->setAveraging(averaging);
+    if( lowFFTDataGenerator != nullptr )
+        lowFFTDataGenerator->setAveraging(averaging);
+}
+
+void PathProducer::setSmoothing(OctaveSmoothing newSmoothing)
+{
+    smoothing = newSmoothing;
+    leftChannelFFTDataGenerator->setSmoothing(smoothing);
+    if( lowFFTDataGenerator != nullptr )
+        lowFFTDataGenerator->setSmoothing(smoothing);
+}
+
+void PathProducer::setMultiResolution(bool shouldUseMultiResolution)
+{
+    if( multiResolution == shouldUseMultiResolution )
+        return;
+    
+    multiResolution = shouldUseMultiResolution;
+    
+    // a new low generator comes with a silent history, and one that is still around from last time has to forget
+    // its own, so the decimation starts from scratch as well
+    if( lowFFTDataGenerator != nullptr )
+    {
+        lowBuffer.clear();
+        lowFFTDataGenerator->resetAveraging();
+    }
+    
+    for( auto& filter : decimationFilters )
+        filter.reset();
+    decimationPhase = 0;
+    
+    latestLowFrame.clear();
+    latestHighFrame.clear();
+    
+    requestGenerators(requestedOrder, multiResolution);
+}
+
+void PathProducer::requestFFTOrder(FFTOrder newOrder)
+{
+    requestedOrder = newOrder;
+    requestGenerators(requestedOrder, multiResolution);
+}
+
+void PathProducer::requestGenerators(FFTOrder order, bool withLowGenerator)
+{
+    const auto requestId = ++handoff->latestRequest;
+    
+    worker->pool.addJob([handoff = handoff, order, withLowGenerator, requestId]()
+    {
+        auto pending = std::make_unique<PendingGenerator>();
+        pending->build(order, withLowGenerator);
+        
+        // a later request supersedes this one, whichever finishes first
+        if( requestId != handoff->latestRequest.load() )
+            return;
+        
+        // replaces a finished generator nobody has picked up yet
+        delete handoff->ready.exchange(pending.release());
+    });
+}
+
+void PathProducer::adoptPendingGenerator()
+{
+    std::unique_ptr<PendingGenerator> pending(handoff->ready.exchange(nullptr));
+    if( pending == nullptr )
+        return;
+    
+    // carry the newest samples over, so the new size doesn't start from silence
+    auto keepNewest = [](const juce::AudioBuffer<float>& from, juce::AudioBuffer<float>& to)
+    {
+        const auto numToKeep = juce::jmin(from.getNumSamples(), to.getNumSamples());
+        to.copyFrom(0, to.getNumSamples() - numToKeep, from, 0, from.getNumSamples() - numToKeep, numToKeep);
+    };
+    
+    keepNewest(monoBuffer, pending->monoBuffer);
+    if( lowFFTDataGenerator != nullptr && pending->lowGenerator != nullptr )
+        keepNewest(lowBuffer, pending->lowBuffer);
+    
+    std::swap(monoBuffer, pending->monoBuffer);
+    std::swap(leftChannelFFTDataGenerator, pending->generator);
+    std::swap(lowBuffer, pending->lowBuffer);
+    std::swap(lowFFTDataGenerator, pending->lowGenerator);
+    
+    for( auto* generator : { leftChannelFFTDataGenerator.get(), lowFFTDataGenerator.get() } )
+    {
+        if( generator == nullptr )
+            continue;
+        
+        generator->setAveraging(averaging);
+        generator->setSmoothing(smoothing);
+    }
+    
+    updateSampleRate(lastSampleRate);
+    
+    // the frames of the old size can't be stitched to the new ones
+    latestLowFrame.clear();
+    latestHighFrame.clear();
+    
+    // pending now holds the old generator and history, let the worker free them
+    std::shared_ptr<PendingGenerator> old(std::move(pending));
+    worker->pool.addJob([old]() mutable { old.reset(); });
+}
+
+/*!
+ @brief Feeds one captured multichannel buffer into the analysis.
+ The signal selected by the channel view is derived straight into the tail of the monoBuffer (after shifting the
+ older samples left), then a new FFT frame is produced from it.
+ @param captured A complete buffer pulled from the processor's MultiChannelSampleFifo.
+ @param sampleRate The rate it was captured at.
+ */
+void PathProducer::pushCapturedBuffer(const juce::AudioBuffer<float>& captured, double sampleRate)
+{
+    using FVO = juce::FloatVectorOperations;
+    
+    adoptPendingGenerator();
+    updateSampleRate(sampleRate);
+    
+    auto size = captured.getNumSamples();
+    const auto numChannels = captured.getNumChannels();
+    
+    jassert(size <= monoBuffer.getNumSamples());
+    size = juce::jmin(size, monoBuffer.getNumSamples());
+    
+    if( numChannels == 0 || size == 0 )
+        return;
+    
+    auto writePointer = monoBuffer.getWritePointer(0, 0);
+    auto readPointer = monoBuffer.getReadPointer(0, size);
+    std::copy(readPointer, (readPointer + monoBuffer.getNumSamples() - size), writePointer);
+    
+    auto* dest = monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size);
+    const auto* left = captured.getReadPointer(0);
+    const auto* right = captured.getReadPointer(juce::jmin(1, numChannels - 1));
+    
+    switch( channelView )
+    {
+        case AnalyzerChannel::Left:
+            FVO::copy(dest, left, size);
+            break;
+        case AnalyzerChannel::Right:
+            FVO::copy(dest, right, size);
+            break;
+        case AnalyzerChannel::Mid:
+            FVO::add(dest, left, right, size);
+            FVO::multiply(dest, 0.5f, size);
+            break;
+        case AnalyzerChannel::Side:
+            FVO::subtract(dest, left, right, size);
+            FVO::multiply(dest, 0.5f, size);
+            break;
+        case AnalyzerChannel::Sum:
+            FVO::copy(dest, left, size);
+            for( int ch = 1; ch < numChannels; ++ch )
+                FVO::add(dest, captured.getReadPointer(ch), size);
+            FVO::multiply(dest, 1.f / float(numChannels), size);
+            break;
+    }
+    
+    leftChannelFFTDataGenerator->produceFFTDataForRendering(monoBuffer, negativeInfinity, size);
+    
+    if( isMultiResolutionReady() )
+        pushDecimated(dest, size);
+}
+
+void PathProducer::updateSampleRate(double sampleRate)
+{
+    if( sampleRate <= 0.0 )
+        return;
+    
+    lastSampleRate = sampleRate;
+    leftChannelFFTDataGenerator->setSampleRate(sampleRate);
+    if( lowFFTDataGenerator != nullptr )
+        lowFFTDataGenerator->setSampleRate(sampleRate / decimationFactor);
+}
+
+/*!
+ @brief Low-pass filters the new samples, keeps every decimationFactor-th of them in the lowBuffer and produces
+ a frame of the low generator from it.
+ @param samples The new samples of the selected channel view, at the full sample rate.
+ @param numSamples The number of new samples.
+ */
+void PathProducer::pushDecimated(const float* samples, int numSamples)
+{
+    if( decimationFilterSampleRate != lastSampleRate )
+    {
+        // cut off at 80% of the decimated Nyquist frequency, everything that survives above it is far above the crossover
+        auto coefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
+                                0.8f * float(lastSampleRate / (2 * decimationFactor)),
+                                lastSampleRate,
+                                2 * static_cast<int>(decimationFilters.size()));
+        
+        for( size_t i = 0; i < decimationFilters.size(); ++i )
+        {
+            decimationFilters[i].coefficients = coefficients[static_cast<int>(i)];
+            decimationFilters[i].reset();
+        }
+        
+        decimationFilterSampleRate = lastSampleRate;
+    }
+    
+    const auto numDecimated = juce::jmin((decimationPhase + numSamples) / decimationFactor, lowBuffer.getNumSamples());
+    const auto historySize = lowBuffer.getNumSamples();
+    
+    // make room at the end of the history, as pushCapturedBuffer() does for the monoBuffer
+    auto* history = lowBuffer.getWritePointer(0);
+    std::copy(history + numDecimated, history + historySize, history);
+    auto* dest = history + historySize - numDecimated;
+    
+    int written = 0;
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto y = samples[i];
+        for( auto& filter : decimationFilters )
+            y = filter.processSample(y);
+        
+        if( ++decimationPhase == decimationFactor )
+        {
+            decimationPhase = 0;
+            if( written < numDecimated )
+                dest[written++] = y;
+        }
+    }
+    
+    if( numDecimated > 0 )
+        lowFFTDataGenerator->produceFFTDataForRendering(lowBuffer, negativeInfinity, numDecimated);
+}
+
 /*!
  @brief Processes FFT data and generates paths.
- This function processes FFT data and generates paths that can be used to render audio data. It uses a LeftChannelFifo buffer to store incoming audio data, a monoBuffer to store the mono representation of the audio data, and LeftChannelFFTDataGenerator to generate FFT data.
+ This function turns the FFT frames produced by pushCapturedBuffer() into paths that can be used to render audio data.
  @param fftBounds The bounds of the FFT data to be rendered.
  @param sampleRate The sample rate of the audio data.
+ @return true if the path returned by getPath() changed.
  */
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+bool PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
 {
-    juce::AudioBuffer<float> tempIncomingBuffer;
-    while( leftChannelFifo->getNumCompleteBuffersAvailable() > 0 )
+    adoptPendingGenerator();
+    updateSampleRate(sampleRate);
+    
+    const auto fftSize = leftChannelFFTDataGenerator->getFFTSize();
+    const auto binWidth = sampleRate / double(fftSize);
+    
+    if( isMultiResolutionReady() )
     {
-        if( leftChannelFifo->getAudioBuffer(tempIncomingBuffer) )
+        // only the newest frame of each resolution matters, they are stitched into a single path
+        auto takeLatest = [](Generator& generator, std::vector<float>& latest)
         {
-            auto size = tempIncomingBuffer.getNumSamples();
+            bool gotFrame = false;
+            while( generator.getNumAvailableFFTDataBlocks() > 0 )
+            {
+                if( auto fftData = generator.readFFTData() )
+                {
+                    // swapping hands the slot equally sized storage back, copy only while latest has the wrong size
+                    if( latest.size() == fftData->size() )
+                        std::swap(latest, *fftData);
+                    else
+                        latest = *fftData;
+                    
+                    gotFrame = true;
+                }
+            }
             
-            // s
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
-            
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
-            std::copy(readPointer, (readPointer + monoBuffer.getNumSamples() - size), writePointer);
-            
-//            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-//                                              monoBuffer.getReadPointer(0, size),
-//                                              monoBuffer.getNumSamples() - size);
-            
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                                              tempIncomingBuffer.getReadPointer(0, 0),
-                                              size);
-            
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
+            return gotFrame;
+        };
+        
+        const auto gotHigh = takeLatest(*leftChannelFFTDataGenerator, latestHighFrame);
+        const auto gotLow = takeLatest(*lowFFTDataGenerator, latestLowFrame);
+        
+        // the listener gets the regular resolution, it covers the whole range in one frame
+        if( gotHigh && frameListener != nullptr )
+            frameListener->fftFrameProduced(latestHighFrame, fftSize, binWidth);
+        
+        if( (gotHigh || gotLow) && ! latestHighFrame.empty() && ! latestLowFrame.empty() )
+        {
+            pathProducer.generateMultiResolutionPath(latestLowFrame,
+                                                     float(binWidth / decimationFactor),
+                                                     latestHighFrame,
+                                                     float(binWidth),
+                                                     float(getCrossoverFrequency(sampleRate)),
+                                                     fftBounds,
+                                                     fftSize,
+                                                     negativeInfinity);
         }
     }
-    
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
-    const auto binWidth = sampleRate / double(fftSize);
-    
-    while( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 )
+    else
     {
-        std::vector<float> fftData;
-        if( leftChannelFFTDataGenerator.getFFTData( fftData) )
+        while( leftChannelFFTDataGenerator->getNumAvailableFFTDataBlocks() > 0 )
         {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
+            if( auto fftData = leftChannelFFTDataGenerator->readFFTData() )
+            {
+                if( frameListener != nullptr )
+                    frameListener->fftFrameProduced(*fftData, fftSize, binWidth);
+                
+                pathProducer.generatePath(*fftData, fftBounds, fftSize, binWidth, negativeInfinity);
+            }
         }
     }
     
+    bool pathChanged = false;
     while( pathProducer.getNumPathsAvailable() > 0 )
     {
-        pathProducer.getPath( leftChannelFFTPath );
+        // swap rather than copy, the slot gets our previous path's storage back for reuse
+        if( auto path = pathProducer.readPath() )
+        {
+            leftChannelFFTPath.swapWithPath(*path);
+            pathChanged = true;
+        }
     }
+    
+    return pathChanged;
 }
 
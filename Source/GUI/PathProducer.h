@@ -12,36 +12,154 @@
 #include <JuceHeader.h>
 #include "FFTDataGenerator.h"
 #include "AnalyzerPathGenerator.h"
+#include "SpectrumTrace.h"
+#include "AnalyzerWorker.h"
 #include "../PluginProcessor.h"
 
 /**
 
 @struct PathProducer
 @brief A class that processes FFT data and generates paths.
-PathProducer class processes FFT data and generates paths that can be used to render audio data. It uses a LeftChannelFifo buffer to store incoming audio data, a monoBuffer to store the mono representation of the audio data, and LeftChannelFFTDataGenerator to generate FFT data.
+PathProducer class processes FFT data and generates paths that can be used to render audio data. It derives the signal selected by its AnalyzerChannel view from the captured multichannel buffers it is fed, keeps the most recent fftSize samples of it in a monoBuffer, and uses LeftChannelFFTDataGenerator to generate FFT data. The FFT size can be changed while the analysis runs, see requestFFTOrder().
 */
 struct PathProducer
 {
-    PathProducer(SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>& scsf) :
-            leftChannelFifo(&scsf)
+    using Generator = FFTDataGenerator<std::vector<float>>;
+    
+    /*!
+     @brief Receives every FFT frame process() turns into a path, e.g. to draw a spectrogram.
+     */
+    struct FrameListener
     {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
-    }
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+        virtual ~FrameListener() = default;
+        /*!
+         @param decibels The frame, at least fftSize / 2 decibel values.
+         @param fftSize The size of the FFT.
+         @param binWidth The width of each bin in Hz.
+         */
+        virtual void fftFrameProduced(const std::vector<float>& decibels, int fftSize, double binWidth) = 0;
+    };
+    
+    PathProducer(AnalyzerChannel view);
+    /*! @param sampleRate The rate the buffer was captured at, the decimation filter and the averaging follow it. */
+    void pushCapturedBuffer(const juce::AudioBuffer<float>& captured, double sampleRate);
+    /*! @return true if a new path replaced the one getPath() returns */
+    bool process(juce::Rectangle<float> fftBounds, double sampleRate);
+    const SpectrumTrace& getPath() const { return leftChannelFFTPath; }
     
     void updateNegativeInfinity(float nf) { negativeInfinity = nf; }
+    void setChannelView(AnalyzerChannel view) { channelView = view; }
+    AnalyzerChannel getChannelView() const { return channelView; }
+    void setAveraging(SpectrumAveraging newAveraging);
+    void setSmoothing(OctaveSmoothing newSmoothing);
+    
+    /*!
+     @brief Asks for a different FFT size.
+     The new generator and its sample history are built on the AnalyzerWorker thread and swapped in by the next
+     pushCapturedBuffer() or process() call, until then the current size keeps running. The old generator is
+     freed on the worker as well, so neither the allocation nor the release happens on the message thread.
+     */
+    void requestFFTOrder(FFTOrder newOrder);
+    FFTOrder getFFTOrder() const { return leftChannelFFTDataGenerator->getOrder(); }
+    
+    /*!
+     @brief Enables the multi-resolution analysis.
+     The signal is also low-pass filtered and decimated by decimationFactor into a second history that feeds a
+     second generator of the same size. That one's bins are decimationFactor times narrower, so the path takes
+     every column below getCrossoverFrequency() from it and the rest from the regular spectrum. Two FFTs of the
+     current size cost far less than one decimationFactor times bigger, for the same resolution in the bass.
+     The second generator and its history only exist while this is enabled. They are built and freed on the
+     AnalyzerWorker like requestFFTOrder() does it, and the regular path is drawn until they arrive.
+     */
+    void setMultiResolution(bool shouldUseMultiResolution);
+    
+    /*! @brief Sets (or clears, with nullptr) the one FrameListener. It must outlive this PathProducer or be cleared first. */
+    void setFrameListener(FrameListener* listener) { frameListener = listener; }
+    
+    static constexpr int decimationFactor = 8;
+    /*! half the decimated Nyquist frequency, well inside the anti-aliasing filter's pass band */
+    static double getCrossoverFrequency(double sampleRate) { return 0.25 * sampleRate / decimationFactor; }
 private:
-    SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>* leftChannelFifo;
+    AnalyzerChannel channelView;
 
     juce::AudioBuffer<float> monoBuffer;
 
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
+    std::unique_ptr<Generator> leftChannelFFTDataGenerator;
+    
+    FrameListener* frameListener { nullptr };
+    
+    bool multiResolution { false };
+    /*! the order of the newest request, so switching multiResolution doesn't undo a pending requestFFTOrder() */
+    FFTOrder requestedOrder { FFTOrder::order2048 };
+    /*! the decimated history and its generator, for the low end of the multi-resolution path. Null while it's off */
+    juce::AudioBuffer<float> lowBuffer;
+    std::unique_ptr<Generator> lowFFTDataGenerator;
+    /*! 8th order Butterworth anti-aliasing filter, as four biquads */
+    std::array<juce::dsp::IIR::Filter<float>, 4> decimationFilters;
+    double decimationFilterSampleRate { 0.0 };
+    int decimationPhase { 0 };
+    /*! the newest frame of each generator, stitched together by process() */
+    std::vector<float> latestLowFrame, latestHighFrame;
+    
+    void pushDecimated(const float* samples, int numSamples);
+    /*! @brief Whether the low generator is in place, it arrives a little after setMultiResolution(true). */
+    bool isMultiResolutionReady() const { return multiResolution && lowFFTDataGenerator != nullptr; }
+    /*! @brief Hands the sample rate to the generators, it converts their averaging times. */
+    void updateSampleRate(double sampleRate);
 
-    AnalyzerPathGenerator<juce::Path> pathProducer;
+    AnalyzerPathGenerator<SpectrumTrace> pathProducer;
 
-    juce::Path leftChannelFFTPath;
+    SpectrumTrace leftChannelFFTPath;
     
     float negativeInfinity {-48.f};
+    
+    SpectrumAveraging averaging { SpectrumAveraging::Off };
+    OctaveSmoothing smoothing { OctaveSmoothing::Off };
+    double lastSampleRate { 44100.0 };
+    
+    /*! a generator built by the worker, together with a history buffer of its fftSize */
+    struct PendingGenerator
+    {
+        std::unique_ptr<Generator> generator;
+        juce::AudioBuffer<float> monoBuffer;
+        std::unique_ptr<Generator> lowGenerator;
+        juce::AudioBuffer<float> lowBuffer;
+        
+        /*! builds the generator, and the low one if asked to, with their (silent) histories, allocates */
+        void build(FFTOrder order, bool withLowGenerator)
+        {
+            generator = std::make_unique<Generator>();
+            generator->changeOrder(order);
+            monoBuffer.setSize(1, generator->getFFTSize());
+            monoBuffer.clear();
+            
+            if( ! withLowGenerator )
+                return;
+            
+            lowGenerator = std::make_unique<Generator>();
+            lowGenerator->changeOrder(order);
+            lowBuffer.setSize(1, lowGenerator->getFFTSize());
+            lowBuffer.clear();
+        }
+    };
+    
+    /*!
+     shared with the worker's jobs so they never touch the PathProducer, which may be gone by the time they run.
+     Only the newest request publishes its generator.
+     */
+    struct GeneratorHandoff
+    {
+        ~GeneratorHandoff() { delete ready.exchange(nullptr); }
+        
+        std::atomic<PendingGenerator*> ready { nullptr };
+        std::atomic<int> latestRequest { 0 };
+    };
+    
+    std::shared_ptr<GeneratorHandoff> handoff { std::make_shared<GeneratorHandoff>() };
+    juce::SharedResourcePointer<AnalyzerWorker> worker;
+    
+    /*! @brief Has the worker build generators of the order, with or without the low one. */
+    void requestGenerators(FFTOrder order, bool withLowGenerator);
+    /*! @brief Swaps in a generator the worker finished, if there is one. */
+    void adoptPendingGenerator();
 };
@@ -11,31 +11,35 @@
 #include "RotarySliderWithLabels.h"
 #include "Utils.h"
 
+namespace
+{
+    const auto startAngle = juce::degreesToRadians(180.f + 45.f);
+    const auto endAngle = juce::degreesToRadians(180.f - 45.f) + juce::MathConstants<float>::twoPi;
+}
+
 /*!
 @brief Paint method for the RotarySliderWithLabels component.
-This method draws the rotary slider and the labels for the component. It uses the
-juce::LookAndFeel_V4 method drawRotarySlider to render the slider, and draws the labels
-by calculating the position of each label and calling the juce::Graphics method
-drawFittedText to render each label.
+This method draws the rotary slider and the labels for the component. The title and the labels come from
+labelLayer, which is only re-rendered when it was invalidated or the display scale changed. It then uses the
+juce::LookAndFeel_V4 method drawRotarySlider to render the slider.
 @param g The juce Graphics context in which to draw the component.
 */
 void RotarySliderWithLabels::paint(juce::Graphics &g)
 {
     using namespace juce;
     
-    auto startAng = degreesToRadians(180.f + 45.f);
-    auto endAng = degreesToRadians(180.f - 45.f) + MathConstants<float>::twoPi;
+    auto startAng = startAngle;
+    auto endAng = endAngle;
     
     auto range = getRange();
     
     auto sliderBounds = getSliderBounds();
-    auto bounds = getLocalBounds();
     
-    g.setColour(Colours::blueviolet);
-    g.drawFittedText(getName(),
-                     bounds.removeFromTop(getTextHeight() + 2),
-                     Justification::centredBottom,
-                     1);
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if( ! labelLayer.isValid() || scale != labelLayerScale )
+        renderLabelLayer(scale);
+    
+    g.drawImage(labelLayer, getLocalBounds().toFloat());
 //    g.setColour(Colours::red);
 //    g.drawRect(getLocalBounds());
 //    g.setColour(Colours::yellow);
@@ -50,6 +54,42 @@ void RotarySliderWithLabels::paint(juce::Graphics &g)
                                       startAng,
                                       endAng,
                                       *this);
+}
+
+void RotarySliderWithLabels::resized()
+{
+    juce::Slider::resized();
+    invalidateLabelLayer();
+}
+
+/*!
+@brief Renders the title and the min/max labels around the knob into labelLayer.
+The image is rendered at the display's physical pixel scale so the text stays crisp on high DPI screens.
+@param scale The physical pixel scale of the context paint() is drawing into.
+*/
+void RotarySliderWithLabels::renderLabelLayer(float scale)
+{
+    using namespace juce;
+    labelLayerScale = scale;
+    
+    auto bounds = getLocalBounds();
+    labelLayer = Image(Image::ARGB,
+                       jmax(1, roundToInt(bounds.getWidth() * scale)),
+                       jmax(1, roundToInt(bounds.getHeight() * scale)),
+                       true);
+    
+    Graphics g(labelLayer);
+    g.addTransform(AffineTransform::scale(scale));
+    
+    auto startAng = startAngle;
+    auto endAng = endAngle;
+    auto sliderBounds = getSliderBounds();
+    
+    g.setColour(Colours::blueviolet);
+    g.drawFittedText(getName(),
+                     bounds.removeFromTop(getTextHeight() + 2),
+                     Justification::centredBottom,
+                     1);
     
     auto center = sliderBounds.toFloat().getCentre();
     auto radius = sliderBounds.getWidth() * 0.5f;
@@ -159,6 +199,7 @@ pointer. It then repaints the component.
 void RotarySliderWithLabels::changeParam(juce::RangedAudioParameter *p)
 {
     param = p;
+    invalidateLabelLayer();
     repaint();
 }
 
@@ -15,6 +15,8 @@
  @struct RotarySliderWithLabels
  @brief A rotary slider with labels.
  RotarySliderWithLabels extends the JUCE Slider class to provide a rotary slider with labels. The labels can be customized and the slider can be associated with a JUCE audio parameter.
+ The title and the min/max labels are rendered into labelLayer once per size and display scale, so a moving knob
+ only redraws its pointer and value text.
  */
 struct RotarySliderWithLabels : juce::Slider
 {
@@ -47,17 +49,25 @@ struct RotarySliderWithLabels : juce::Slider
     juce::Array<LabelPos> labels;
     
     void paint(juce::Graphics& g) override;
+    void resized() override;
     juce::Rectangle<int> getSliderBounds() const;
     int getTextHeight() const { return 14; }
     // DOC: virtual makes it overrideable
     virtual juce::String getDisplayString() const;
     
     void changeParam(juce::RangedAudioParameter* p);
+    
+    /*! @brief Re-renders the title and labels on the next paint. changeParam() calls this, call it after editing labels otherwise. */
+    void invalidateLabelLayer() { labelLayer = juce::Image(); }
     // DOC: we need to make private -> protected so the derrived class can access them.
 protected:
     //    LookAndFeel lnf;
     juce::RangedAudioParameter* param;
     juce::String suffix;
+private:
+    juce::Image labelLayer;
+    float labelLayerScale { 0.f };
+    void renderLabelLayer(float scale);
 };
 
 
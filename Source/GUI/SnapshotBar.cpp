@@ -0,0 +1,91 @@
+/*
+ ==============================================================================
+
+ SnapshotBar.cpp
+ Created: 19 Oct 2026 9:47:03pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "SnapshotBar.h"
+
+SnapshotBar::SnapshotBar(SimpleMBCompAudioProcessor& p) :
+audioProcessor(p)
+{
+    auto& snapshots = audioProcessor.getSnapshots();
+
+    for( size_t slot = 0; slot < numSnapshots; ++slot )
+    {
+        const auto name = juce::String::charToString(static_cast<juce::juce_wchar>('A' + slot));
+
+        auto& store = storeButtons[slot];
+        store.setButtonText("Store " + name);
+        store.setTooltip("Store the current settings as snapshot " + name);
+        store.onClick = [this, slot]() { audioProcessor.storeSnapshot(slot); };
+        addAndMakeVisible(store);
+
+        auto& recallButton = recallButtons[slot];
+        recallButton.setButtonText(name);
+        recallButton.setTooltip("Switch to snapshot " + name);
+        recallButton.onClick = [this, slot]() { moveTo(float(slot)); };
+        addAndMakeVisible(recallButton);
+    }
+
+    morphButton.setTooltip("Let the snapshots drive the audio instead of the parameters");
+    morphButton.setToggleState(snapshots.isEngaged(), juce::NotificationType::dontSendNotification);
+    morphButton.onClick = [this]() { audioProcessor.getSnapshots().setEngaged(morphButton.getToggleState()); };
+    addAndMakeVisible(morphButton);
+
+    morphSlider.setRange(0.0, double(numSnapshots - 1));
+    morphSlider.setValue(snapshots.getPosition(), juce::NotificationType::dontSendNotification);
+    morphSlider.setTooltip("Morph between the snapshots");
+    morphSlider.onValueChange = [this]() { moveTo(static_cast<float>(morphSlider.getValue())); };
+    addAndMakeVisible(morphSlider);
+
+    applyButton.setTooltip("Write the morphed settings to the parameters");
+    applyButton.onClick = [this]() { audioProcessor.applySnapshotMorph(); };
+    addAndMakeVisible(applyButton);
+}
+
+void SnapshotBar::moveTo(float position)
+{
+    auto& snapshots = audioProcessor.getSnapshots();
+    snapshots.setPosition(position);
+    snapshots.setEngaged(true);
+
+    morphSlider.setValue(position, juce::NotificationType::dontSendNotification);
+    morphButton.setToggleState(true, juce::NotificationType::dontSendNotification);
+}
+
+void SnapshotBar::refresh()
+{
+    morphButton.setToggleState(audioProcessor.getSnapshots().isEngaged(), juce::NotificationType::dontSendNotification);
+}
+
+void SnapshotBar::resized()
+{
+    auto bounds = getLocalBounds().reduced(0, 3);
+
+    for( auto& store : storeButtons )
+        store.setBounds(bounds.removeFromLeft(65).withTrimmedLeft(4));
+
+    applyButton.setBounds(bounds.removeFromRight(55).withTrimmedRight(4));
+    morphButton.setBounds(bounds.removeFromRight(70).withTrimmedRight(4));
+
+    // every recall button sits where the slider it jumps to would put the thumb: the first and last at either
+    // end, any in between over the track at their slot's share of its length
+    constexpr int recallWidth = 30;
+    recallButtons.front().setBounds(bounds.removeFromLeft(recallWidth).withTrimmedLeft(8));
+    recallButtons.back().setBounds(bounds.removeFromRight(recallWidth).withTrimmedRight(8));
+
+    const auto track = bounds.reduced(4, 0);
+    morphSlider.setBounds(track);
+
+    for( size_t slot = 1; slot + 1 < numSnapshots; ++slot )
+    {
+        const auto centre = track.getX() + juce::roundToInt(track.getWidth() * float(slot) / float(numSnapshots - 1));
+        recallButtons[slot].setBounds(track.withWidth(recallWidth - 8).withCentre({ centre, track.getCentreY() }));
+        recallButtons[slot].toFront(false);
+    }
+}
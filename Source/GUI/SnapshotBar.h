@@ -0,0 +1,43 @@
+/*
+ ==============================================================================
+
+ SnapshotBar.h
+ Created: 19 Oct 2026 9:47:03pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*!
+ @class SnapshotBar
+ @brief The controls of the processor's snapshots: store the current settings in a slot, jump to a slot or
+ morph between them with the slider, and apply the morph to the parameters.
+ Jumping and morphing only move the SnapshotMorph's position and engage it, the audio thread does the rest, so
+ no parameter changes and the host sees nothing until Apply.
+ */
+struct SnapshotBar : juce::Component
+{
+    SnapshotBar(SimpleMBCompAudioProcessor& p);
+
+    void resized() override;
+
+    /*! @brief Picks up the morph being disengaged elsewhere, e.g. by Apply. Call once per frame. */
+    void refresh();
+private:
+    SimpleMBCompAudioProcessor& audioProcessor;
+
+    static constexpr size_t numSnapshots = SimpleMBCompAudioProcessor::NumSnapshots;
+
+    std::array<juce::TextButton, numSnapshots> storeButtons;
+    std::array<juce::TextButton, numSnapshots> recallButtons;
+    juce::ToggleButton morphButton { "Morph" };
+    juce::Slider morphSlider { juce::Slider::LinearHorizontal, juce::Slider::NoTextBox };
+    juce::TextButton applyButton { "Apply" };
+
+    /*! @brief Moves the morph to a position, 0 is the first slot, and engages it. */
+    void moveTo(float position);
+};
@@ -0,0 +1,146 @@
+/*
+ ==============================================================================
+
+ Spectrogram.cpp
+ Created: 19 Oct 2026 6:48:25pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "Spectrogram.h"
+#include "Utils.h"
+
+Spectrogram::Spectrogram()
+{
+    buildColourTable();
+    setOpaque(true);
+}
+
+/*!
+ @brief Fills the colour table, from black for NEGATIVE_INFINITY through blue, purple and orange to a pale yellow for MAX_DECIBALS.
+ */
+void Spectrogram::buildColourTable()
+{
+    using namespace juce;
+    ColourGradient gradient(Colours::black, 0.f, 0.f, Colour(255u, 250u, 200u), 1.f, 0.f, false);
+    gradient.addColour(0.25, Colour(20u, 20u, 120u));
+    gradient.addColour(0.5, Colour(97u, 18u, 167u));
+    gradient.addColour(0.75, Colours::orange);
+
+    for( size_t i = 0; i < colourTable.size(); ++i )
+        colourTable[i] = gradient.getColourAtPosition(double(i) / double(colourTable.size() - 1)).getPixelARGB();
+}
+
+juce::Rectangle<int> Spectrogram::getHistoryArea() const
+{
+    // inside the border drawModuleBackground() draws
+    return getLocalBounds().reduced(6);
+}
+
+void Spectrogram::resized()
+{
+    auto area = getHistoryArea();
+
+    if( area.isEmpty() )
+    {
+        history = juce::Image();
+        return;
+    }
+
+    history = juce::Image(juce::Image::ARGB, area.getWidth(), area.getHeight(), false);
+    history.clear(history.getBounds(), juce::Colours::black);
+    writeIndex = 0;
+
+    const auto numRows = static_cast<size_t>(area.getHeight());
+    firstBin.assign(numRows, 0);
+    endBin.assign(numRows, 1);
+    rowsFFTSize = -1;
+}
+
+/*!
+ @brief Works out which bins every image row covers, on the analyzer's log frequency scale. Only runs when the
+ height, fftSize or bin width changed.
+ */
+void Spectrogram::updateRows(int fftSize, double binWidth)
+{
+    if( fftSize == rowsFFTSize && binWidth == rowsBinWidth )
+        return;
+
+    rowsFFTSize = fftSize;
+    rowsBinWidth = binWidth;
+
+    const auto numRows = static_cast<int>(firstBin.size());
+    const auto numBins = fftSize / 2;
+
+    for( int y = 0; y < numRows; ++y )
+    {
+        // row 0 is the top, i.e. the highest frequencies
+        const auto upper = juce::mapToLog10(1.0 - double(y) / numRows, double(MIN_FREQUENCY), double(MAX_FREQUENCY));
+        const auto lower = juce::mapToLog10(1.0 - double(y + 1) / numRows, double(MIN_FREQUENCY), double(MAX_FREQUENCY));
+
+        const auto first = juce::jlimit(0, numBins - 1, static_cast<int>(lower / binWidth));
+        const auto end = juce::jlimit(first + 1, numBins, static_cast<int>(std::ceil(upper / binWidth)));
+
+        firstBin[static_cast<size_t>(y)] = first;
+        endBin[static_cast<size_t>(y)] = end;
+    }
+}
+
+void Spectrogram::fftFrameProduced(const std::vector<float>& decibels, int fftSize, double binWidth)
+{
+    using namespace juce;
+
+    if( ! history.isValid() || static_cast<int>(decibels.size()) < fftSize / 2 )
+        return;
+
+    updateRows(fftSize, binWidth);
+
+    const auto scale = float(colourTable.size() - 1) / (MAX_DECIBALS - NEGATIVE_INFINITY);
+    const auto maxIndex = static_cast<int>(colourTable.size()) - 1;
+
+    Image::BitmapData bitmap(history, writeIndex, 0, 1, history.getHeight(), Image::BitmapData::writeOnly);
+    auto* pixel = bitmap.getPixelPointer(0, 0);
+
+    for( int y = 0; y < bitmap.height; ++y, pixel += bitmap.lineStride )
+    {
+        const auto* first = decibels.data() + firstBin[static_cast<size_t>(y)];
+        const auto* last = decibels.data() + endBin[static_cast<size_t>(y)];
+        const auto level = *std::max_element(first, last);
+
+        const auto index = jlimit(0, maxIndex, static_cast<int>((level - NEGATIVE_INFINITY) * scale));
+        *reinterpret_cast<PixelARGB*>(pixel) = colourTable[static_cast<size_t>(index)];
+    }
+
+    writeIndex = (writeIndex + 1) % history.getWidth();
+    hasNewColumns = true;
+}
+
+void Spectrogram::refresh()
+{
+    if( ! hasNewColumns )
+        return;
+
+    hasNewColumns = false;
+    repaint(getHistoryArea());
+}
+
+void Spectrogram::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    g.fillAll(Colours::black);
+    drawModuleBackground(g, getLocalBounds());
+
+    if( ! history.isValid() )
+        return;
+
+    const auto area = getHistoryArea();
+    const auto height = history.getHeight();
+    const auto numOldest = history.getWidth() - writeIndex;
+
+    // oldest columns on the left, newest on the right
+    g.drawImage(history, area.getX(), area.getY(), numOldest, height, writeIndex, 0, numOldest, height);
+
+    if( writeIndex > 0 )
+        g.drawImage(history, area.getX() + numOldest, area.getY(), writeIndex, height, 0, 0, writeIndex, height);
+}
@@ -0,0 +1,53 @@
+/*
+ ==============================================================================
+
+ Spectrogram.h
+ Created: 19 Oct 2026 6:48:25pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+#include "PathProducer.h"
+
+/*!
+ @class Spectrogram
+ @brief A scrolling waterfall of the analyzer's FFT frames: time runs left to right, frequency bottom to top on a
+ log scale, and level is colour.
+ Each frame becomes one column of a ring-indexed image: the column at writeIndex is overwritten through a
+ precomputed row-to-bin table and a 256 entry colour table, and writeIndex moves on. A frame therefore costs
+ O(height) and the history is never redrawn. paint() shows the ring in time order with two blits, the oldest
+ columns from writeIndex to the end, then the newest from 0 to writeIndex.
+ */
+struct Spectrogram : juce::Component,
+PathProducer::FrameListener
+{
+    Spectrogram();
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    /*! @brief Writes one column from a frame of decibel values. Message thread. */
+    void fftFrameProduced(const std::vector<float>& decibels, int fftSize, double binWidth) override;
+
+    /*! @brief Repaints the history area if a column was written since the last call. */
+    void refresh();
+private:
+    juce::Image history;
+    /*! the column the next frame goes to, everything right of it is older */
+    int writeIndex { 0 };
+    bool hasNewColumns { false };
+
+    /*! image row y shows the bins [firstBin[y], endBin[y]) */
+    std::vector<int> firstBin, endBin;
+    int rowsFFTSize { -1 };
+    double rowsBinWidth { -1.0 };
+    void updateRows(int fftSize, double binWidth);
+
+    std::array<juce::PixelARGB, 256> colourTable;
+    void buildColourTable();
+
+    juce::Rectangle<int> getHistoryArea() const;
+};
@@ -15,85 +15,111 @@
 /*!
  @brief Constructor for the SpectrumAnalyzer class.
  The constructor initializes the leftPathProducer and rightPathProducer with
- the leftChannelFifo and rightChannelFifo of the SimpleMBCompAudioProcessor instance.
- It also adds a listener to each parameter of the audio processor. Finally, it starts
- a timer with a frequency of 60 times per second.
+ the left and right channel views of the processor's analyzerFifo.
+ It also looks up the parameters it draws and attaches to the processor's capture.
  @param p - A reference to the SimpleMBCompAudioProcessor instance.
  */
 SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
 audioProcessor(p),
-leftPathProducer(audioProcessor.leftChannelFifo),
-rightPathProducer(audioProcessor.rightChannelFifo)
+leftPathProducer(AnalyzerChannel::Left),
+rightPathProducer(AnalyzerChannel::Right)
 {
-    
-    const juce::Array<juce::AudioProcessorParameter*>& params = audioProcessor.getParameters();
-    for( auto param : params )
-    {
-        param->addListener(this);
-    }
+    parameterVersion = audioProcessor.pollParameterVersion();
     
     using namespace Params;
-    const auto& paramNames = GetParams();
+    auto& apvts = audioProcessor.apvts;
     
-    auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
-    {
-        // we have a reference to the param member var here and we set it to value from apvts
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
-        jassert(param != nullptr);
-    };
+    lowMidXoverParam = &get<juce::AudioParameterFloat>(apvts, Names::Low_Mid_Crossover_Freq);
+    midHighXoverParam = &get<juce::AudioParameterFloat>(apvts, Names::Mid_High_Crossover_Freq);
+    
+    lowThresholdParam = &get<juce::AudioParameterFloat>(apvts, Names::Threshold_Low_Band);
+    midThresholdParam = &get<juce::AudioParameterFloat>(apvts, Names::Threshold_Mid_Band);
+    highThresholdParam = &get<juce::AudioParameterFloat>(apvts, Names::Threshold_High_Band);
     
-    floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
     
-    floatHelper(lowThresholdParam, Names::Threshold_Low_Band);
-    floatHelper(midThresholdParam, Names::Threshold_Mid_Band);
-    floatHelper(highThresholdParam, Names::Threshold_High_Band);
+    updateAnalyzerAttachment();
     
+    // the background image covers every pixel, so repainting part of us never has to repaint the editor behind
+    setOpaque(true);
+}
+
+void SpectrumAnalyzer::updateAnalyzerAttachment()
+{
+    if( shouldShowFFTAnalysis && ! attachedToProcessor )
+        audioProcessor.attachAnalyzer();
+    else if( ! shouldShowFFTAnalysis && attachedToProcessor )
+        audioProcessor.detachAnalyzer();
     
-    // starts the timer with a frequency of 60x per second
-    startTimerHz(60);
+    attachedToProcessor = shouldShowFFTAnalysis;
 }
 
 /*!
  @brief SpectrumAnalyzer destructor.
- Removes listener from all the parameters of the audio processor.
+ Detaches from the processor's capture.
  */
 SpectrumAnalyzer::~SpectrumAnalyzer()
 {
-    const juce::Array<juce::AudioProcessorParameter*>& params = audioProcessor.getParameters();
-    for( auto param : params )
+    if( attachedToProcessor )
+        audioProcessor.detachAnalyzer();
+    
+    if( shouldShowBandSpectra )
+        audioProcessor.detachBandAnalyzer();
+}
+
+void SpectrumAnalyzer::setShowBandSpectra(bool shouldShow)
+{
+    if( shouldShow == shouldShowBandSpectra )
+        return;
+    
+    shouldShowBandSpectra = shouldShow;
+    analysisAreaDirty = true;
+    
+    if( shouldShow )
     {
-        param->removeListener(this);
+        bandSpectra.reset();
+        audioProcessor.attachBandAnalyzer();
+    }
+    else
+    {
+        audioProcessor.detachBandAnalyzer();
     }
 }
 
 
+/*!
+ @brief Draws both traces.
+ The traces are rasterised by traceRenderer into an image covering the analysis area, at the display's physical
+ pixel scale, and that image is blitted in one go. This replaces a strokePath() per trace.
+ */
 void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> bounds)
 {
     using namespace juce;
-    auto leftChannelFFTPath = leftPathProducer.getPath();
     auto responseArea = getAnalysisArea(bounds);
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
     
-    /* Somehow this reduces the box size (there was a white line we wanted to cover over) */
-    Graphics::ScopedSaveState sss(g);
-    g.reduceClipRegion(responseArea);
+    traceRenderer.setSize(responseArea.getWidth(), responseArea.getHeight(), scale);
+    traceRenderer.beginFrame();
     
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(),
-                                                                    0
-                                                                    //                                                                      responseArea.getY()
-                                                                    ));
+    // the traces' x starts at 0 for the left edge of the analysis area, their y is in component coordinates
+    const Point<float> origin(0.f, float(responseArea.getY()));
     
-    g.setColour(Colour(97u, 18u, 167u)); //purple-
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
+    traceRenderer.drawTrace(leftPathProducer.getPath(), Colour(97u, 18u, 167u), origin); //purple-
+    traceRenderer.drawTrace(rightPathProducer.getPath(), Colour(215u, 201u, 134u), origin);
     
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(),
-                                                                     0
-                                                                     //                                                                         responseArea.getY()
-                                                                     ));
+    if( shouldShowBandSpectra )
+    {
+        const std::array<Colour, BandSpectra::numBands> bandColours
+        {
+            Colour(64u, 160u, 255u),    // low
+            Colour(0u, 200u, 120u),     // mid
+            Colour(255u, 110u, 90u)     // high
+        };
+        
+        for( int band = 0; band < BandSpectra::numBands; ++band )
+            traceRenderer.drawTrace(bandSpectra.getTrace(band), bandColours[static_cast<size_t>(band)], origin);
+    }
     
-    g.setColour(Colour(215u, 201u, 134u));
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+    g.drawImage(traceRenderer.getImage(), responseArea.toFloat());
 }
 
 /*!
@@ -106,39 +132,47 @@ void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> b
 void SpectrumAnalyzer::paint (juce::Graphics& g)
 {
     using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (Colours::black);
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
     
-    auto bounds = drawModuleBackground(g, getLocalBounds());
+    if( ! backgroundImage.isValid() || scale != backgroundScale )
+        renderBackground(scale);
     
-    drawBackgroundGrid(g, bounds);
-    
-    auto responseArea = getAnalysisArea(bounds);
+    // (Our component is opaque, and the background image covers all of it)
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
     
     if( shouldShowFFTAnalysis )
     {
-        drawFFTAnalysis(g, bounds);
-        
+        drawFFTAnalysis(g, contentBounds);
     }
     
-    g.setColour(Colours::white);
-    //    g.strokePath(responseCurve, PathStrokeType(2.f));
+    drawCrossovers(g, contentBounds);
+}
+
+/*!
+ @brief Renders the static layer: the module background, the grid and the text labels.
+ The image is rendered at the display's physical pixel scale so the text stays crisp on high DPI screens.
+ @param scale The physical pixel scale of the context paint() is drawing into.
+ */
+void SpectrumAnalyzer::renderBackground(float scale)
+{
+    using namespace juce;
+    backgroundScale = scale;
+    
+    const auto bounds = getLocalBounds();
+    backgroundImage = Image(Image::RGB,
+                            jmax(1, roundToInt(bounds.getWidth() * scale)),
+                            jmax(1, roundToInt(bounds.getHeight() * scale)),
+                            false);
+    
+    Graphics g(backgroundImage);
+    g.addTransform(AffineTransform::scale(scale));
     
-    //    Path border;
-    //
-    //    border.setUsingNonZeroWinding(false);
-    //
-    //    border.addRoundedRectangle(getRenderArea(bounds), 4);
-    //    border.addRectangle(getLocalBounds());
-    //
-    //    g.setColour(Colours::black);
+    g.fillAll (Colours::black);
     
-    //    g.fillPath(border);
+    contentBounds = drawModuleBackground(g, bounds);
     
-    drawCrossovers(g, bounds);
-    drawTextLabels(g, bounds);
-    //    g.setColour(Colours::orange);
-    //    g.drawRoundedRectangle(getRenderArea(bounds).toFloat(), 4.f, 1.f);
+    drawBackgroundGrid(g, contentBounds);
+    drawTextLabels(g, contentBounds);
 }
 
 void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bounds)
@@ -185,25 +219,30 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bo
     g.drawHorizontalLine(mapY(highThresholdParam->get()), midHighX, right);
 }
 
-void SpectrumAnalyzer::update(const std::vector<float> &values)
+void SpectrumAnalyzer::update(const SimpleMBCompAudioProcessor::Meters& meters)
+{
+    static_assert( SimpleMBCompAudioProcessor::NumBands == 3, "the analyzer draws a low, mid and high band" );
+    
+    lowBandGR = meters.bands[0].gainReductionDb;
+    midBandGR = meters.bands[1].gainReductionDb;
+    highBandGR = meters.bands[2].gainReductionDb;
+}
+
+juce::Range<float> SpectrumAnalyzer::getGainReductionRows()
 {
-    jassert(values.size() == 6);
+    using namespace juce;
+    const auto area = getAnalysisArea(contentBounds).toFloat();
     
-    enum
+    auto mapY = [&area](float db)
     {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
+        return jmap(db, NEGATIVE_INFINITY, MAX_DECIBALS, area.getBottom(), area.getY());
     };
     
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
+    const auto zerodB = mapY(0.f);
+    const auto deepest = mapY(jmin(lowBandGR, midBandGR, highBandGR));
+    const auto highest = mapY(jmax(lowBandGR, midBandGR, highBandGR));
     
-    repaint();
+    return { jmin(zerodB, highest), jmax(zerodB, deepest) };
 }
 
 
@@ -395,6 +434,11 @@ void SpectrumAnalyzer::drawTextLabels(juce::Graphics &g, juce::Rectangle<int> bo
 void SpectrumAnalyzer::resized()
 {
     using namespace juce;
+    backgroundImage = Image();
+    // the same area drawModuleBackground() returns, refresh() needs it before the first paint
+    contentBounds = getLocalBounds().reduced(3);
+    analysisAreaDirty = true;
+    
     auto bounds = getLocalBounds();
     auto fftBounds = getAnalysisArea(bounds).toFloat();
     auto negInf = jmap(bounds.toFloat().getBottom(), fftBounds.getBottom(), fftBounds.getY(), NEGATIVE_INFINITY, MAX_DECIBALS);
@@ -402,29 +446,16 @@ void SpectrumAnalyzer::resized()
     DBG("Negative infinity: " << negInf);
     leftPathProducer.updateNegativeInfinity(negInf);
     rightPathProducer.updateNegativeInfinity(negInf);
+    negativeInfinity = negInf;
 }
 
 /*!
- @brief Callback method that is triggered when a parameter value has changed.
- This method is called by Juce when a parameter value has changed. The method sets
- the parametersChanged flag to true so that the timerCallback method will
- update the visual representation of the parameters.
- @param parameterIndex Index of the parameter that has changed
- @param newValue The new value of the parameter
- */
-void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
-{
-    parametersChanged.set(true);
-}
-
-/*!
- @brief Creates callback to frame by frame for the spectrum analyzer
- The timerCallback method is called at a frequency determined by startTimerHz. It performs the following tasks:
- If shouldShowFFTAnalysis is true, it calls the process method on leftPathProducer and rightPathProducer, passing in the analysis area bounds and the sample rate of the audio processor.
- If parametersChanged is true, it sets it to false.
- It calls the repaint method to redraw the component.
+ @brief Pulls the frame's analyzer data and invalidates only what changed.
+ If shouldShowFFTAnalysis is true, it drains the processor's analyzerFifo into both path producers and calls the process method on leftPathProducer and rightPathProducer, passing in the analysis area bounds and the sample rate of the audio processor.
+ A new trace or a parameter change repaints the analysis area. Otherwise, when only the meters moved, just the
+ rows between the previous and the new gain reduction rectangles are repainted, and nothing at all when nothing changed.
  */
-void SpectrumAnalyzer::timerCallback()
+void SpectrumAnalyzer::refresh()
 {
     if( shouldShowFFTAnalysis )
     {
@@ -433,17 +464,67 @@ void SpectrumAnalyzer::timerCallback()
         fftBounds.setBottom(bounds.getBottom());
         auto sampleRate = audioProcessor.getSampleRate();
         
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
+        // the capture fifo has a single consumer, so drain it here and feed both traces from each buffer
+        auto& analyzerFifo = audioProcessor.analyzerFifo;
+        while( analyzerFifo.getNumCompleteBuffersAvailable() > 0 )
+        {
+            if( auto captured = analyzerFifo.readAudioBuffer() )
+            {
+                leftPathProducer.pushCapturedBuffer(*captured, sampleRate);
+                rightPathProducer.pushCapturedBuffer(*captured, sampleRate);
+            }
+        }
+        
+        // no short circuit, both producers have to consume their frames
+        const auto leftChanged = leftPathProducer.process(fftBounds, sampleRate);
+        const auto rightChanged = rightPathProducer.process(fftBounds, sampleRate);
+        analysisAreaDirty |= leftChanged || rightChanged;
+        
+        if( shouldShowBandSpectra )
+        {
+            auto& bandFifo = audioProcessor.bandAnalyzerFifo;
+            while( bandFifo.getNumCompleteBuffersAvailable() > 0 )
+            {
+                if( auto captured = bandFifo.readAudioBuffer() )
+                    bandSpectra.pushCapturedBuffer(*captured);
+            }
+            
+            analysisAreaDirty |= bandSpectra.process(fftBounds, sampleRate, negativeInfinity);
+        }
     }
     
-    if( parametersChanged.compareAndSetBool(false, true) )
+    // any parameter change redraws the crossovers and thresholds
+    const auto currentParameterVersion = audioProcessor.pollParameterVersion();
+    if( currentParameterVersion != parameterVersion )
     {
+        parameterVersion = currentParameterVersion;
+        analysisAreaDirty = true;
+    }
+    
+    const auto grRows = getGainReductionRows();
+    
+    if( analysisAreaDirty )
+    {
+        repaint(getAnalysisArea(contentBounds));
+    }
+    else if( grRows.getStart() != paintedGRTop || grRows.getEnd() != paintedGRBottom )
+    {
+        const auto area = getAnalysisArea(contentBounds);
+        const auto top = juce::jmin(grRows.getStart(), paintedGRTop);
+        const auto bottom = juce::jmax(grRows.getEnd(), paintedGRBottom);
         
-        
+        repaint(area.withTop(static_cast<int>(std::floor(top)) - 1)
+                    .withBottom(static_cast<int>(std::ceil(bottom)) + 1)
+                    .getIntersection(area));
+    }
+    else
+    {
+        return;
     }
     
-    repaint();
+    analysisAreaDirty = false;
+    paintedGRTop = grRows.getStart();
+    paintedGRBottom = grRows.getEnd();
 }
 
 
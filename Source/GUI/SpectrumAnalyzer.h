@@ -11,24 +11,25 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PathProducer.h"
+#include "BandSpectra.h"
 
 /*!
  @class SpectrumAnalyzer
  @brief A JUCE component that displays the audio spectrum analysis.
  The SpectrumAnalyzer class is a component that listens to audio processing parameters and displays the audio spectrum analysis. It uses a PathProducer to generate paths from the audio data, and draws these paths on the component. The component also handles redrawing the background grid and text labels as needed.
+ It has no timer of its own, the editor calls refresh() once per display frame. It doesn't listen to the
+ parameters either, refresh() polls the processor's parameter version instead.
  */
-struct SpectrumAnalyzer: juce::Component,
-juce::AudioProcessorParameter::Listener,
-juce::Timer
+struct SpectrumAnalyzer: juce::Component
 {
     SpectrumAnalyzer(SimpleMBCompAudioProcessor&);
     ~SpectrumAnalyzer();
     
-    void parameterValueChanged (int parameterIndex, float newValue) override;
-    
-    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
-    
-    void timerCallback() override;
+    /*!
+     @brief Pulls new analyzer data and invalidates whatever changed since the last call.
+     Only the analysis area is ever repainted, the rest of the component is the static background.
+     */
+    void refresh();
     
     void paint(juce::Graphics& g) override;
     void resized() override;
@@ -36,15 +37,79 @@ juce::Timer
     void toggleAnalysisEnablement(bool enabled)
     {
         shouldShowFFTAnalysis = enabled;
+        updateAnalyzerAttachment();
+        analysisAreaDirty = true;
+    }
+    
+    /*!
+     @brief Chooses which signal each of the two traces shows, e.g. Mid and Side instead of Left and Right.
+     */
+    void setChannelViews(AnalyzerChannel first, AnalyzerChannel second)
+    {
+        leftPathProducer.setChannelView(first);
+        rightPathProducer.setChannelView(second);
+    }
+    
+    /*! @brief How both traces average their frames over time, see SpectrumAveraging. */
+    void setAveraging(SpectrumAveraging averaging)
+    {
+        leftPathProducer.setAveraging(averaging);
+        rightPathProducer.setAveraging(averaging);
+    }
+    
+    /*! @brief Fractional-octave smoothing of both traces. */
+    void setSmoothing(OctaveSmoothing smoothing)
+    {
+        leftPathProducer.setSmoothing(smoothing);
+        rightPathProducer.setSmoothing(smoothing);
+    }
+    
+    /*! @brief The FFT size of both traces, applied once the worker thread has built the new generators. */
+    void setFFTOrder(FFTOrder order)
+    {
+        leftPathProducer.requestFFTOrder(order);
+        rightPathProducer.requestFFTOrder(order);
+    }
+    
+    /*! @brief Switches both traces to the multi-resolution analysis, see PathProducer::setMultiResolution(). */
+    void setMultiResolution(bool shouldUseMultiResolution)
+    {
+        leftPathProducer.setMultiResolution(shouldUseMultiResolution);
+        rightPathProducer.setMultiResolution(shouldUseMultiResolution);
     }
     
-    void update(const std::vector<float>& values);
+    /*!
+     @brief Feeds the frames of the first trace to a waterfall view as well, nullptr stops it.
+     */
+    void setFrameListener(PathProducer::FrameListener* listener) { leftPathProducer.setFrameListener(listener); }
+    
+    /*!
+     @brief Overlays the output spectrum of every band. The processor only captures the bands while this is on.
+     */
+    void setShowBandSpectra(bool shouldShow);
+    
+    void update(const SimpleMBCompAudioProcessor::Meters& meters);
 private:
     SimpleMBCompAudioProcessor& audioProcessor;
     
     bool shouldShowFFTAnalysis = true;
+    bool attachedToProcessor = false;
+    
+    /*! attaches to the processor's capture while the analysis is shown, so a hidden analyzer costs the audio thread nothing */
+    void updateAnalyzerAttachment();
+    
+    /*! the processor's parameter version at the last refresh(), see ParameterVersion */
+    uint32_t parameterVersion { 0 };
     
-    juce::Atomic<bool> parametersChanged { false };
+    /*!
+     The module background, grid and labels only change with the size and the display scale, so they are
+     rendered into backgroundImage once and paint() just blits it. resized() throws the image away.
+     */
+    juce::Image backgroundImage;
+    float backgroundScale { 0.f };
+    /*! the area inside the module border, as returned by drawModuleBackground() */
+    juce::Rectangle<int> contentBounds;
+    void renderBackground(float scale);
     
 //    void drawBackgroundGrid(juce::Graphics& g);
     void drawBackgroundGrid(juce::Graphics& g, juce::Rectangle<int> bounds);
@@ -60,6 +125,11 @@ private:
     
     PathProducer leftPathProducer, rightPathProducer;
     
+    BandSpectra bandSpectra;
+    bool shouldShowBandSpectra = false;
+    float negativeInfinity { NEGATIVE_INFINITY };
+    SpectrumTraceRenderer traceRenderer;
+    
     void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
     void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
     
@@ -73,4 +143,12 @@ private:
     float lowBandGR { 0.f };
     float midBandGR { 0.f };
     float highBandGR { 0.f };
+    
+    /*! what the last repaint covered, so refresh() can invalidate just the region the meters moved through */
+    float paintedGRTop { 0.f };
+    float paintedGRBottom { 0.f };
+    bool analysisAreaDirty { true };
+    
+    /*! @return the rows spanned by the 0 dB line and every band's gain reduction */
+    juce::Range<float> getGainReductionRows();
 };
@@ -0,0 +1,171 @@
+/*
+ ==============================================================================
+
+ SpectrumTrace.cpp
+ Created: 19 Oct 2026 2:31:07pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#include "SpectrumTrace.h"
+
+void SpectrumTraceRenderer::setSize(int width, int height, float newScale)
+{
+    const auto physicalWidth = juce::jmax(0, juce::roundToInt(width * newScale));
+    const auto physicalHeight = juce::jmax(0, juce::roundToInt(height * newScale));
+    scale = newScale;
+
+    if( image.isValid() && image.getWidth() == physicalWidth && image.getHeight() == physicalHeight )
+        return;
+
+    if( physicalWidth == 0 || physicalHeight == 0 )
+    {
+        image = juce::Image();
+        return;
+    }
+
+    image = juce::Image(juce::Image::ARGB, physicalWidth, physicalHeight, true);
+
+    const auto numColumns = static_cast<size_t>(physicalWidth);
+    spanTop.assign(numColumns, 0.f);
+    spanBottom.assign(numColumns, 0.f);
+    dirtyTop.assign(numColumns, 0);
+    dirtyBottom.assign(numColumns, 0);
+}
+
+void SpectrumTraceRenderer::beginFrame()
+{
+    if( ! image.isValid() )
+        return;
+
+    juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::writeOnly);
+
+    for( int x = 0; x < bitmap.width; ++x )
+    {
+        auto& top = dirtyTop[static_cast<size_t>(x)];
+        auto& bottom = dirtyBottom[static_cast<size_t>(x)];
+
+        auto* pixel = bitmap.getPixelPointer(x, top);
+        for( int y = top; y < bottom; ++y, pixel += bitmap.lineStride )
+            std::memset(pixel, 0, static_cast<size_t>(bitmap.pixelStride));
+
+        top = bottom = 0;
+    }
+}
+
+void SpectrumTraceRenderer::drawTrace(const SpectrumTrace& trace,
+                                      juce::Colour colour,
+                                      juce::Point<float> origin,
+                                      float thickness)
+{
+    using namespace juce;
+
+    const auto numPoints = trace.getNumPoints();
+    if( ! image.isValid() || numPoints == 0 )
+        return;
+
+    const auto width = image.getWidth();
+    const auto height = image.getHeight();
+    const auto* points = trace.data();
+
+    auto toImage = [origin, s = scale](Point<float> p)
+    {
+        return Point<float>((p.x - origin.x) * s, (p.y - origin.y) * s);
+    };
+
+    auto toColumn = [width](float x)
+    {
+        return jlimit(0, width - 1, static_cast<int>(std::floor(x)));
+    };
+
+    const auto firstColumn = toColumn(toImage(points[0]).x);
+    const auto lastColumn = toColumn(toImage(points[numPoints - 1]).x);
+
+    for( int x = firstColumn; x <= lastColumn; ++x )
+    {
+        spanTop[static_cast<size_t>(x)] = std::numeric_limits<float>::max();
+        spanBottom[static_cast<size_t>(x)] = std::numeric_limits<float>::lowest();
+    }
+
+    // 1) the vertical extent of every segment within each column it crosses
+    auto a = toImage(points[0]);
+    for( int i = (numPoints > 1 ? 1 : 0); i < numPoints; ++i )
+    {
+        const auto b = toImage(points[i]);
+        jassert(b.x >= a.x); // traces must run left to right
+
+        if( b.x >= 0.f && a.x < float(width) )
+        {
+            const auto c0 = toColumn(a.x);
+            const auto c1 = juce::jmax(c0, toColumn(std::ceil(b.x) - 1.f));
+            const auto slope = b.x > a.x ? (b.y - a.y) / (b.x - a.x) : 0.f;
+
+            for( int x = c0; x <= c1; ++x )
+            {
+                const auto x0 = jmax(a.x, float(x));
+                const auto x1 = jmin(b.x, float(x + 1));
+                const auto y0 = b.x > a.x ? a.y + (x0 - a.x) * slope : a.y;
+                const auto y1 = b.x > a.x ? a.y + (x1 - a.x) * slope : b.y;
+
+                auto& top = spanTop[static_cast<size_t>(x)];
+                auto& bottom = spanBottom[static_cast<size_t>(x)];
+                top = jmin(top, y0, y1);
+                bottom = jmax(bottom, y0, y1);
+            }
+        }
+
+        a = b;
+    }
+
+    // 2) one anti-aliased span per column
+    const auto halfThickness = 0.5f * thickness * scale;
+    const auto solid = colour.getPixelARGB();
+
+    Image::BitmapData bitmap(image, Image::BitmapData::readWrite);
+
+    for( int x = firstColumn; x <= lastColumn; ++x )
+    {
+        if( spanTop[static_cast<size_t>(x)] > spanBottom[static_cast<size_t>(x)] )
+            continue;
+
+        const auto top = jmax(0.f, spanTop[static_cast<size_t>(x)] - halfThickness);
+        const auto bottom = jmin(float(height), spanBottom[static_cast<size_t>(x)] + halfThickness);
+        if( bottom <= top )
+            continue;
+
+        const auto firstRow = static_cast<int>(top);
+        const auto endRow = jmin(height, static_cast<int>(std::ceil(bottom)));
+
+        auto* pixel = bitmap.getPixelPointer(x, firstRow);
+        for( int y = firstRow; y < endRow; ++y, pixel += bitmap.lineStride )
+        {
+            auto& dest = *reinterpret_cast<PixelARGB*>(pixel);
+            const auto coverage = jmin(bottom, float(y + 1)) - jmax(top, float(y));
+
+            if( coverage >= 1.f )
+            {
+                dest.blend(solid);
+            }
+            else
+            {
+                auto partial = solid;
+                partial.multiplyAlpha(coverage);
+                dest.blend(partial);
+            }
+        }
+
+        auto& dirtyRowsTop = dirtyTop[static_cast<size_t>(x)];
+        auto& dirtyRowsBottom = dirtyBottom[static_cast<size_t>(x)];
+        if( dirtyRowsBottom == dirtyRowsTop )
+        {
+            dirtyRowsTop = firstRow;
+            dirtyRowsBottom = endRow;
+        }
+        else
+        {
+            dirtyRowsTop = jmin(dirtyRowsTop, firstRow);
+            dirtyRowsBottom = jmax(dirtyRowsBottom, endRow);
+        }
+    }
+}
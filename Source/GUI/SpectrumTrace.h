@@ -0,0 +1,82 @@
+/*
+ ==============================================================================
+
+ SpectrumTrace.h
+ Created: 19 Oct 2026 2:31:07pm
+ Author:  zack
+
+ ==============================================================================
+ */
+
+#pragma once
+#include <JuceHeader.h>
+
+/*!
+ @class SpectrumTrace
+ @brief A polyline whose points move left to right, the shape every analyzer trace has.
+ It offers the subset of the juce::Path interface AnalyzerPathGenerator uses, so the generator can build a
+ SpectrumTrace instead of a Path. clear() keeps the storage, so a trace reused every frame never allocates.
+ */
+struct SpectrumTrace
+{
+    /*! @brief Removes every point but keeps the storage. */
+    void clear() noexcept { points.clear(); }
+
+    /*! @param numElements a juce::Path style element count, i.e. 3 per lineTo */
+    void preallocateSpace(int numElements) { points.reserve(static_cast<size_t>(numElements / 3 + 1)); }
+
+    /*! @brief A trace is a single polyline, so this just adds the first point. */
+    void startNewSubPath(float x, float y) { points.push_back({ x, y }); }
+    void lineTo(float x, float y) { points.push_back({ x, y }); }
+
+    void swapWithPath(SpectrumTrace& other) noexcept { points.swap(other.points); }
+
+    bool isEmpty() const noexcept { return points.empty(); }
+    int getNumPoints() const noexcept { return static_cast<int>(points.size()); }
+    const juce::Point<float>* data() const noexcept { return points.data(); }
+private:
+    std::vector<juce::Point<float>> points;
+};
+
+/*!
+ @class SpectrumTraceRenderer
+ @brief Rasterises SpectrumTraces straight into a cached ARGB image.
+ Because x only ever increases along a trace, every pixel column is covered by one vertical span, from the lowest
+ to the highest point the trace reaches inside that column, widened by the line thickness. drawTrace() works out
+ those spans and fills each with a single pass down the column, anti-aliasing the two end pixels by their
+ coverage. There is no edge table and no path flattening.
+ beginFrame() only clears the spans the previous frame touched, so the image is never wiped in full.
+ */
+struct SpectrumTraceRenderer
+{
+    /*!
+     @brief Sizes the image. It is only reallocated when the physical size changes.
+     @param width The width in logical pixels.
+     @param height The height in logical pixels.
+     @param scale The physical pixel scale of the display, so the trace stays sharp on high DPI screens.
+     */
+    void setSize(int width, int height, float scale);
+
+    /*! @brief Erases what the previous frame drew. Call once before the drawTrace() calls of a frame. */
+    void beginFrame();
+
+    /*!
+     @brief Draws a trace on top of whatever this frame has drawn so far.
+     @param trace The points, in logical coordinates.
+     @param colour The colour of the line.
+     @param origin The logical position that maps to the image's top left corner.
+     @param thickness The line thickness in logical pixels.
+     */
+    void drawTrace(const SpectrumTrace& trace, juce::Colour colour, juce::Point<float> origin, float thickness = 1.f);
+
+    /*! @brief The rendered frame, draw it over the logical bounds passed to setSize(). */
+    const juce::Image& getImage() const noexcept { return image; }
+private:
+    juce::Image image;
+    float scale { 1.f };
+
+    /*! the vertical extent of the trace in each column, in physical pixels */
+    std::vector<float> spanTop, spanBottom;
+    /*! the rows [dirtyTop, dirtyBottom) of each column hold pixels drawn since the last beginFrame() */
+    std::vector<int> dirtyTop, dirtyBottom;
+};
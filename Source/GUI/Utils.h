@@ -23,7 +23,8 @@ enum FFTOrder
 {
     order2048 = 11,
     order4096 = 12,
-    order8192 = 13
+    order8192 = 13,
+    order16384 = 14
 };
 
 
@@ -36,58 +37,27 @@ enum FFTOrder
 # define MIN_THRESHOLD -60.f
 
 /*!
-@brief Helper function to create an AudioProcessorValueTreeState attachment.
-@tparam Attachment Type of the attachment to be created.
-@tparam APVTS Type of the AudioProcessorValueTreeState.
-@tparam Params Type of the parameter map.
-@tparam ParamName Type of the parameter name.
-@tparam SliderType Type of the slider to be attached to the parameter.
+@brief Helper function to create a parameter attachment.
+@tparam Attachment Type of the attachment to be created, e.g. juce::SliderParameterAttachment.
+@tparam ParamType Type of the parameter, usually what Params::get() returned.
+@tparam SliderType Type of the slider or button to be attached to the parameter.
 @param attachment [out] Pointer to the unique_ptr that holds the attachment.
-@param apvts Reference to the AudioProcessorValueTreeState.
-@param params Map of parameters.
-@param name Name of the parameter to be attached.
+@param param The parameter to attach to.
 @param slider Slider to be attached to the parameter.
 */
 template<
 typename Attachment,
-typename APVTS,
-typename Params,
-typename ParamName,
+typename ParamType,
 typename SliderType
 >
 void makeAttachment(std::unique_ptr<Attachment>& attachment,
-                    APVTS& apvts,
-                    const Params& params,
-                    const ParamName& name,
+                    ParamType& param,
                     SliderType& slider)
 {
-    attachment = std::make_unique<Attachment>(apvts, params.at(name), slider);
+    attachment = std::make_unique<Attachment>(param, slider);
 }
 
 
-/*!
- @brief Gets parameters from the Params enum. Just gets the value from a key in a hashmap
- @tparam APVTS APVTS
- @tparam Params Just the params hashmap
- @tparam Name Usually a string
- @param APVts& apvts The APVTS
- @param Params& params A reference to the params hash.
- @param Name&  name A reference to the string name of the param
- @return juce::RangedAudioParameter& A reference to the audio parameter associated with Name.
- */
-template<
-typename APVTS,
-typename Params,
-typename Name
->
-juce::RangedAudioParameter& getParam(APVTS& apvts, const Params& params, const Name& name)
-{
-    auto param = apvts.getParameter(params.at(name));
-    jassert(param != nullptr);
-    
-    return *param;
-}
-
 /*!
  @brief Just returns true if number is over 1000. Works for any number type.
  @param T& value The number to check
@@ -21,6 +21,42 @@ ControlBar::ControlBar()
 {
     analyzerButton.setToggleState(true, juce::NotificationType::dontSendNotification);
     addAndMakeVisible(analyzerButton);
+    
+    // item ids are the AnalyzerTap values + 1, ComboBox reserves 0 for "nothing selected"
+    analyzerTapSelector.addItemList({"Input", "Trim", "Low", "Mid", "High", "Output"}, 1);
+    analyzerTapSelector.setTooltip("Where the analyzer listens");
+    addAndMakeVisible(analyzerTapSelector);
+    
+    // item ids are the SpectrumAveraging values + 1
+    averagingSelector.addItemList({"Raw", "Average", "RMS", "Hold", "Decay"}, 1);
+    averagingSelector.setSelectedId(static_cast<int>(SpectrumAveraging::Off) + 1, juce::NotificationType::dontSendNotification);
+    averagingSelector.setTooltip("How the analyzer averages over time");
+    addAndMakeVisible(averagingSelector);
+    
+    // item ids are the OctaveSmoothing values + 1
+    smoothingSelector.addItemList({"No Smoothing", "1/3 Oct", "1/6 Oct", "1/12 Oct"}, 1);
+    smoothingSelector.setSelectedId(static_cast<int>(OctaveSmoothing::Off) + 1, juce::NotificationType::dontSendNotification);
+    smoothingSelector.setTooltip("Fractional-octave smoothing of the analyzer");
+    addAndMakeVisible(smoothingSelector);
+    
+    // item ids are the FFTOrder values
+    fftSizeSelector.addItem("2048", FFTOrder::order2048);
+    fftSizeSelector.addItem("4096", FFTOrder::order4096);
+    fftSizeSelector.addItem("8192", FFTOrder::order8192);
+    fftSizeSelector.addItem("16384", FFTOrder::order16384);
+    fftSizeSelector.setSelectedId(FFTOrder::order2048, juce::NotificationType::dontSendNotification);
+    fftSizeSelector.setTooltip("FFT size of the analyzer");
+    addAndMakeVisible(fftSizeSelector);
+    
+    multiResolutionButton.setTooltip("Analyse the low end with a decimated, higher resolution FFT");
+    addAndMakeVisible(multiResolutionButton);
+    
+    waterfallButton.setTooltip("Show a scrolling spectrogram next to the analyzer");
+    addAndMakeVisible(waterfallButton);
+    
+    bandSpectraButton.setTooltip("Overlay the output spectrum of each band");
+    addAndMakeVisible(bandSpectraButton);
+    
     addAndMakeVisible(globalBypassButton);
 }
 
@@ -29,6 +65,13 @@ void ControlBar::resized()
     auto bounds = getLocalBounds();
     
     analyzerButton.setBounds(bounds.removeFromLeft(50).withTrimmedTop(4).withTrimmedBottom(4));
+    analyzerTapSelector.setBounds(bounds.removeFromLeft(80).withTrimmedTop(4).withTrimmedBottom(4).withTrimmedLeft(4));
+    averagingSelector.setBounds(bounds.removeFromLeft(80).withTrimmedTop(4).withTrimmedBottom(4).withTrimmedLeft(4));
+    smoothingSelector.setBounds(bounds.removeFromLeft(100).withTrimmedTop(4).withTrimmedBottom(4).withTrimmedLeft(4));
+    fftSizeSelector.setBounds(bounds.removeFromLeft(70).withTrimmedTop(4).withTrimmedBottom(4).withTrimmedLeft(4));
+    multiResolutionButton.setBounds(bounds.removeFromLeft(90).withTrimmedTop(2).withTrimmedBottom(2).withTrimmedLeft(4));
+    waterfallButton.setBounds(bounds.removeFromLeft(75).withTrimmedTop(2).withTrimmedBottom(2).withTrimmedLeft(4));
+    bandSpectraButton.setBounds(bounds.removeFromLeft(55).withTrimmedTop(2).withTrimmedBottom(2).withTrimmedLeft(4));
     globalBypassButton.setBounds(bounds.removeFromRight(50).withTrimmedTop(2).withTrimmedBottom(2));
 }
 
@@ -46,20 +89,74 @@ SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBComp
         analyzer.toggleAnalysisEnablement(shouldBeOn);
     };
     
+    controlBar.analyzerTapSelector.setSelectedId(static_cast<int>(audioProcessor.getAnalyzerTap()) + 1,
+                                                 juce::NotificationType::dontSendNotification);
+    controlBar.analyzerTapSelector.onChange = [this]()
+    {
+        auto selectedId = controlBar.analyzerTapSelector.getSelectedId();
+        if( selectedId > 0 )
+            audioProcessor.setAnalyzerTap(static_cast<AnalyzerTap>(selectedId - 1));
+    };
+    
+    controlBar.averagingSelector.onChange = [this]()
+    {
+        auto selectedId = controlBar.averagingSelector.getSelectedId();
+        if( selectedId > 0 )
+            analyzer.setAveraging(static_cast<SpectrumAveraging>(selectedId - 1));
+    };
+    
+    controlBar.smoothingSelector.onChange = [this]()
+    {
+        auto selectedId = controlBar.smoothingSelector.getSelectedId();
+        if( selectedId > 0 )
+            analyzer.setSmoothing(static_cast<OctaveSmoothing>(selectedId - 1));
+    };
+    
+    controlBar.fftSizeSelector.onChange = [this]()
+    {
+        auto selectedId = controlBar.fftSizeSelector.getSelectedId();
+        if( selectedId > 0 )
+            analyzer.setFFTOrder(static_cast<FFTOrder>(selectedId));
+    };
+    
+    controlBar.multiResolutionButton.onClick = [this]()
+    {
+        analyzer.setMultiResolution(controlBar.multiResolutionButton.getToggleState());
+    };
+    
+    controlBar.waterfallButton.onClick = [this]()
+    {
+        setWaterfallVisible(controlBar.waterfallButton.getToggleState());
+    };
+    
+    controlBar.bandSpectraButton.onClick = [this]()
+    {
+        analyzer.setShowBandSpectra(controlBar.bandSpectraButton.getToggleState());
+    };
+    
     controlBar.globalBypassButton.onClick = [this]()
     {
         toggleGlobalBypassState();
     };
+    
+    // the items have to be there before the attachment selects one
+    auto& channelLinkParam = Params::get<juce::AudioParameterChoice>(audioProcessor.apvts, Params::Names::Channel_Link);
+    channelLinkSelector.addItemList(channelLinkParam.choices, 1);
+    channelLinkSelector.setTooltip("Which channels share a detector: none, the left/right pairs of the layout, or all of them");
+    makeAttachment(channelLinkAttachment, channelLinkParam, channelLinkSelector);
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
     addAndMakeVisible(controlBar);
+    addAndMakeVisible(snapshotBar);
+    addAndMakeVisible(channelLinkSelector);
     addAndMakeVisible(analyzer);
+    addChildComponent(spectrogram);
+    addAndMakeVisible(gainReductionLane);
     addAndMakeVisible(globalControls);
     addAndMakeVisible(bandControls);
     
-    setSize (600, 500);
-    
-    startTimerHz(60);
+    // wide enough for every analyzer control in the control bar, tall enough for the gain reduction lane and the snapshot bar
+    setSize (660, 588);
 }
 
 /*!
@@ -67,9 +164,20 @@ SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBComp
  */
 SimpleMBCompAudioProcessorEditor::~SimpleMBCompAudioProcessorEditor()
 {
+    analyzer.setFrameListener(nullptr);
     setLookAndFeel(nullptr);
 }
 
+/*!
+ @brief Shows or hides the spectrogram. While hidden it isn't fed, so it costs nothing.
+ */
+void SimpleMBCompAudioProcessorEditor::setWaterfallVisible(bool shouldBeVisible)
+{
+    analyzer.setFrameListener(shouldBeVisible ? &spectrogram : nullptr);
+    spectrogram.setVisible(shouldBeVisible);
+    resized();
+}
+
 /*!
  @brief Sets font color, etc. for the main parent UI component.
  */
@@ -93,12 +201,20 @@ void SimpleMBCompAudioProcessorEditor::resized()
     auto bounds = getLocalBounds();
     //top section
     controlBar.setBounds( bounds.removeFromTop(32) );
+    auto snapshotArea = bounds.removeFromTop(28);
+    channelLinkSelector.setBounds( snapshotArea.removeFromRight(100).reduced(4, 3) );
+    snapshotBar.setBounds( snapshotArea );
     
     //bottom section
     bandControls.setBounds( bounds.removeFromBottom(135) );
     
-    // middle section
-    analyzer.setBounds(bounds.removeFromTop(225));
+    // middle section, the spectrogram takes the right third when it's shown
+    auto analyzerArea = bounds.removeFromTop(225);
+    if( spectrogram.isVisible() )
+        spectrogram.setBounds(analyzerArea.removeFromRight(analyzerArea.getWidth() / 3));
+    analyzer.setBounds(analyzerArea);
+    
+    gainReductionLane.setBounds(bounds.removeFromTop(60));
     
     // second from bottom. remainder of bounds
     globalControls.setBounds(bounds);
@@ -107,20 +223,35 @@ void SimpleMBCompAudioProcessorEditor::resized()
     // subcomponents in your editor..
 }
 
-void SimpleMBCompAudioProcessorEditor::timerCallback()
+bool SimpleMBCompAudioProcessorEditor::isVisibleOnScreen()
 {
-    // TODO: this is suspicious... make sure its not bad practice to work with a dynamic structure in this callback
-    std::vector<float> values
+    if( ! isShowing() )
+        return false;
+    
+    auto* peer = getPeer();
+    return peer != nullptr && ! peer->isMinimised();
+}
+
+void SimpleMBCompAudioProcessorEditor::refresh()
+{
+    if( ! isVisibleOnScreen() )
     {
-        audioProcessor.lowBandComp.getRmsLevelInputDb(),
-        audioProcessor.lowBandComp.getRmsLevelOutputDb(),
-        audioProcessor.midBandComp.getRmsLevelInputDb(),
-        audioProcessor.midBandComp.getRmsLevelOutputDb(),
-        audioProcessor.highBandComp.getRmsLevelInputDb(),
-        audioProcessor.highBandComp.getRmsLevelOutputDb(),
-    };
+        if( ++framesSinceHiddenRefresh < hiddenRefreshInterval )
+            return;
+        
+        framesSinceHiddenRefresh = 0;
+        updateGlobalBypassButton();
+        return;
+    }
     
-    analyzer.update(values);
+    framesSinceHiddenRefresh = 0;
+    
+    // one consistent snapshot of the last audio block, nothing is allocated
+    analyzer.update(audioProcessor.getMeters());
+    analyzer.refresh();
+    spectrogram.refresh();
+    gainReductionLane.refresh();
+    snapshotBar.refresh();
     updateGlobalBypassButton();
 }
 
@@ -156,28 +287,16 @@ void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState()
     bandControls.toggleAllBands(! shouldEnableEverything);
 }
 
-std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams()
+std::array<juce::AudioParameterBool*, SimpleMBCompAudioProcessor::NumBands> SimpleMBCompAudioProcessorEditor::getBypassParams()
 {
     using namespace Params;
-    using namespace juce;
-    const auto& params = Params::GetParams();
-    auto& apvts = audioProcessor.apvts;
     
-    auto boolHelper = [&apvts, &params](const auto& paramName)
-    {
-        auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-        
-        return param;
-    };
-    auto* lowBypassParam = boolHelper(Names::Bypassed_Low_Band);
-    auto* midBypassParam = boolHelper(Names::Bypassed_Mid_Band);
-    auto* highBypassParam = boolHelper(Names::Bypassed_High_Band);
-    return {
-        lowBypassParam,
-        midBypassParam,
-        highBypassParam
-    };
+    // O(1) per band, see Params::get()
+    std::array<juce::AudioParameterBool*, SimpleMBCompAudioProcessor::NumBands> bypassParams;
+    for( size_t band = 0; band < bypassParams.size(); ++band )
+        bypassParams[band] = &get<juce::AudioParameterBool>(audioProcessor.apvts, forBand(BandParam::Bypassed, band));
+    
+    return bypassParams;
 }
 
 
@@ -15,6 +15,9 @@
 #include "GUI/GlobalControls.h"
 #include "GUI/CompressorBandControls.h"
 #include "GUI/SpectrumAnalyzer.h"
+#include "GUI/Spectrogram.h"
+#include "GUI/GainReductionLane.h"
+#include "GUI/SnapshotBar.h"
 
 #include "GUI/SpectrumAnalyzer.h"
 #include "GUI/CustomButtons.h"
@@ -25,6 +28,13 @@ struct ControlBar : juce::Component
     void resized() override;
     
     AnalyzerButton analyzerButton;
+    juce::ComboBox analyzerTapSelector;
+    juce::ComboBox averagingSelector;
+    juce::ComboBox smoothingSelector;
+    juce::ComboBox fftSizeSelector;
+    juce::ToggleButton multiResolutionButton { "Hi-Res Lows" };
+    juce::ToggleButton waterfallButton { "Waterfall" };
+    juce::ToggleButton bandSpectraButton { "Bands" };
     PowerButton globalBypassButton;
 };
 
@@ -39,11 +49,11 @@ The GlobalControls component displays the global controls for the audio effect,
 
 The SimpleMBCompAudioProcessorEditor class also includes a member variable for a LookAndFeel object, which is used to provide a custom appearance for the different components in the UI.
 
-The SimpleMBCompAudioProcessorEditor class overrides the paint() and resized() methods to update the appearance of the components in the UI whenever the window is redrawn or resized. The class also has a reference to the SimpleMBCompAudioProcessor object, allowing it to access the processor's parameters and audio data.
+The SimpleMBCompAudioProcessorEditor class overrides the paint() and resized() methods to update the appearance of the components in the UI whenever the window is redrawn or resized. All periodic UI work is driven from refresh(), which a juce::VBlankAttachment calls once per display frame. The class also has a reference to the SimpleMBCompAudioProcessor object, allowing it to access the processor's parameters and audio data.
 
 @see SimpleMBCompAudioProcessor, GlobalControls, CompressorBandControls, SpectrumAnalyzer
 */
-class SimpleMBCompAudioProcessorEditor  : public juce::AudioProcessorEditor, juce::Timer
+class SimpleMBCompAudioProcessorEditor  : public juce::AudioProcessorEditor
 {
 public:
     SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor&);
@@ -52,7 +62,6 @@ public:
     //==============================================================================
     void paint (juce::Graphics&) override;
     void resized() override;
-    void timerCallback() override;
     
 private:
     LookAndFeel lnf;
@@ -61,13 +70,37 @@ private:
     SimpleMBCompAudioProcessor& audioProcessor;
     
     ControlBar controlBar;
+    /*! A/B snapshots and the morph between them, under the control bar */
+    SnapshotBar snapshotBar { audioProcessor };
+    /*! how the compressors link their detectors across channels, next to the snapshot bar */
+    juce::ComboBox channelLinkSelector;
+    std::unique_ptr<juce::ComboBoxParameterAttachment> channelLinkAttachment;
     GlobalControls globalControls { audioProcessor.apvts };
     // TODO add a breakpoint in this block to see when exactly this block runs
     CompressorBandControls bandControls { audioProcessor.apvts };
     SpectrumAnalyzer analyzer { audioProcessor };
+    /*! shown next to the analyzer while the waterfall button is on */
+    Spectrogram spectrogram;
+    void setWaterfallVisible(bool shouldBeVisible);
+    /*! the last seconds of every band's gain reduction, under the analyzer */
+    GainReductionLane gainReductionLane { audioProcessor };
+    
+    /*!
+     @brief The single per-frame update: pulls the meters and the analyzer data once and lets each component
+     invalidate what changed. While the editor isn't visible on screen it only polls the bypass state a few times a second.
+     */
+    void refresh();
+    bool isVisibleOnScreen();
+    
+    /*! the number of vblanks between refreshes while hidden or minimised */
+    static constexpr int hiddenRefreshInterval = 30;
+    int framesSinceHiddenRefresh { 0 };
+    
+    // declared last so it's destroyed first, the callback touches the components above
+    juce::VBlankAttachment vBlankAttachment { this, [this]() { refresh(); } };
     
     void toggleGlobalBypassState();
-    std::array<juce::AudioParameterBool*, 3> getBypassParams();
+    std::array<juce::AudioParameterBool*, SimpleMBCompAudioProcessor::NumBands> getBypassParams();
     void updateGlobalBypassButton();
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
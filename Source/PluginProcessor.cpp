@@ -10,6 +10,7 @@
 #include "PluginEditor.h"
 #include "DSP/CompressorBand.h"
 #include "DSP/Params.h"
+#include "DSP/BinaryState.h"
 
 //==============================================================================
 /**
@@ -33,67 +34,7 @@ SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
                   )
 #endif
 {
-    using namespace Params;
-    const auto params = GetParams();
-    
-    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        // we have a reference to the param member var here and we set it to value from apvts
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-    };
-    
-    // Attack / Release
-    floatHelper(lowBandComp.attack, Names::Attack_Low_Band);
-    floatHelper(lowBandComp.release, Names::Release_Low_Band);
-    floatHelper(lowBandComp.threshold, Names::Threshold_Low_Band);
-    
-    floatHelper(midBandComp.attack, Names::Attack_Mid_Band);
-    floatHelper(midBandComp.release, Names::Release_Mid_Band);
-    floatHelper(midBandComp.threshold, Names::Threshold_Mid_Band);
-    
-    floatHelper(highBandComp.attack, Names::Attack_High_Band);
-    floatHelper(highBandComp.release, Names::Release_High_Band);
-    floatHelper(highBandComp.threshold, Names::Threshold_High_Band);
-    
-    // Gain
-    floatHelper(inputGainParam, Names::Gain_In);
-    floatHelper(outputGainParam, Names::Gain_Out);
-    
-    // Ratio
-    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        // we have a reference to the param member var here and we set it to value from apvts
-        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-    };
-    
-    choiceHelper(lowBandComp.ratio, Names::Ratio_Low_Band);
-    choiceHelper(midBandComp.ratio, Names::Ratio_Mid_Band);
-    choiceHelper(highBandComp.ratio, Names::Ratio_High_Band);
-    
-    // Bypass
-    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        // we have a reference to the param member var here and we set it to value from apvts
-        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-    };
-    
-    boolHelper(lowBandComp.bypassed, Names::Bypassed_Low_Band);
-    boolHelper(midBandComp.bypassed, Names::Bypassed_Mid_Band);
-    boolHelper(highBandComp.bypassed, Names::Bypassed_High_Band);
-    
-    boolHelper(lowBandComp.mute, Names::Mute_Low_Band);
-    boolHelper(midBandComp.mute, Names::Mute_Mid_Band);
-    boolHelper(highBandComp.mute, Names::Mute_High_Band);
-    
-    boolHelper(lowBandComp.solo, Names::Solo_Low_Band);
-    boolHelper(midBandComp.solo, Names::Solo_Mid_Band);
-    boolHelper(highBandComp.solo, Names::Solo_High_Band);
-    
-    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighCrossover, Names::Mid_High_Crossover_Freq);
+    static_assert( Params::NumBands == NumBands, "the parameter table and the processor disagree on the number of bands" );
     
     LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
     HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
@@ -102,6 +43,8 @@ SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
     
     LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
     HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    
+    parameterVersion.prepare(getParameters());
 }
 
 SimpleMBCompAudioProcessor::~SimpleMBCompAudioProcessor()
@@ -187,19 +130,11 @@ void SimpleMBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
     spec.numChannels = getTotalNumInputChannels();
     spec.sampleRate = sampleRate;
     
-    // Important! auto& because we need to reference and call THE OBJECT ITSELF NOT A COPY
-    for(auto& compressor : compressors)
-    {
-        compressor.prepare(spec);
-    }
-    
-    LP1.prepare(spec);
-    HP1.prepare(spec);
+    crossover.prepare(spec);
     
-    AP2.prepare(spec);
-    
-    LP2.prepare(spec);
-    HP2.prepare(spec);
+    const auto layout = getChannelLayoutOfBus(true, 0);
+    for( auto link : { ChannelLink::Off, ChannelLink::Pairs, ChannelLink::All } )
+        channelGroups[static_cast<size_t>(link)] = ChannelGroups::make(layout, static_cast<int>(spec.numChannels), link);
     
     inputGain.prepare(spec);
     outputGain.prepare(spec);
@@ -207,13 +142,54 @@ void SimpleMBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
     inputGain.setRampDurationSeconds(0.05);
     outputGain.setRampDurationSeconds(0.05);
     
+    snapshots.prepare(sampleRate);
+    lowMidCutoff.reset(sampleRate, 0.05);
+    midHighCutoff.reset(sampleRate, 0.05);
+    for( auto& level : bandLevels )
+        level.reset(sampleRate, Snapshots::rampSeconds);
+    
+    // start out at the current settings, there's nothing to glide from yet
+    updateState(0);
+    lowMidCutoff.setCurrentAndTargetValue(blockValues[Params::Low_Mid_Crossover_Freq]);
+    midHighCutoff.setCurrentAndTargetValue(blockValues[Params::Mid_High_Crossover_Freq]);
+    setCrossoverFrequencies(lowMidCutoff.getCurrentValue(), midHighCutoff.getCurrentValue());
+    for( auto& level : bandLevels )
+        level.setCurrentAndTargetValue(level.getTargetValue());
+    
+    // after updateState(), so every band starts out fully bypassed or fully compressing as its settings say
+    // Important! auto& because we need to reference and call THE OBJECT ITSELF NOT A COPY
+    for(auto& compressor : compressors)
+    {
+        compressor.prepare(spec);
+    }
+    
+    loudnessMeter.prepare(sampleRate, getChannelLayoutOfBus(true, 0), static_cast<int>(spec.numChannels));
+    
     for(auto& buffer : filterBuffers)
     {
         buffer.setSize(static_cast<int>(spec.numChannels), samplesPerBlock);
     }
     
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+    {
+        const juce::ScopedLock sl(analyzerLock);
+        analyzerNumChannels = static_cast<int>(spec.numChannels);
+        analyzerBlockSize = samplesPerBlock;
+        
+        // the audio thread is stopped, so this is the safe place to (re)size or drop the capture buffers
+        if( numAnalyzerConsumers > 0 )
+            analyzerFifo.prepare(analyzerNumChannels, analyzerBlockSize);
+        else
+            analyzerFifo.release();
+        
+        analyzerConsumerActive.store(numAnalyzerConsumers > 0);
+        
+        if( numBandAnalyzerConsumers > 0 )
+            prepareBandCapture();
+        else
+            releaseBandCapture();
+        
+        bandAnalyzerActive.store(numBandAnalyzerConsumers > 0);
+    }
     
     osc.initialise([]( float x ){ return std::sin(x); });
     osc.prepare(spec);
@@ -228,6 +204,95 @@ void SimpleMBCompAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    const juce::ScopedLock sl(analyzerLock);
+    if( numAnalyzerConsumers == 0 )
+        analyzerFifo.release();
+    if( numBandAnalyzerConsumers == 0 )
+        releaseBandCapture();
+}
+
+void SimpleMBCompAudioProcessor::attachAnalyzer()
+{
+    const juce::ScopedLock sl(analyzerLock);
+    ++numAnalyzerConsumers;
+    
+    // capturing is off until now, so the audio thread isn't touching the fifo while we allocate it.
+    // if it is already prepared it has the current size: prepareToPlay drops it while nobody is attached.
+    if( ! analyzerFifo.isPrepared() && analyzerBlockSize > 0 )
+        analyzerFifo.prepare(analyzerNumChannels, analyzerBlockSize);
+    
+    analyzerConsumerActive.store(analyzerFifo.isPrepared());
+}
+
+void SimpleMBCompAudioProcessor::detachAnalyzer()
+{
+    const juce::ScopedLock sl(analyzerLock);
+    jassert(numAnalyzerConsumers > 0);
+    numAnalyzerConsumers = juce::jmax(0, numAnalyzerConsumers - 1);
+    
+    // the buffers stay until the audio thread stops, it may still be halfway through an update()
+    if( numAnalyzerConsumers == 0 )
+        analyzerConsumerActive.store(false);
+}
+
+void SimpleMBCompAudioProcessor::attachBandAnalyzer()
+{
+    const juce::ScopedLock sl(analyzerLock);
+    ++numBandAnalyzerConsumers;
+    
+    if( ! bandAnalyzerFifo.isPrepared() && analyzerBlockSize > 0 )
+        prepareBandCapture();
+    
+    bandAnalyzerActive.store(bandAnalyzerFifo.isPrepared());
+}
+
+void SimpleMBCompAudioProcessor::detachBandAnalyzer()
+{
+    const juce::ScopedLock sl(analyzerLock);
+    jassert(numBandAnalyzerConsumers > 0);
+    numBandAnalyzerConsumers = juce::jmax(0, numBandAnalyzerConsumers - 1);
+    
+    if( numBandAnalyzerConsumers == 0 )
+        bandAnalyzerActive.store(false);
+}
+
+void SimpleMBCompAudioProcessor::prepareBandCapture()
+{
+    bandAnalyzerFifo.prepare(static_cast<int>(NumBands), analyzerBlockSize);
+    bandCaptureBuffer.setSize(static_cast<int>(NumBands), analyzerBlockSize);
+}
+
+void SimpleMBCompAudioProcessor::releaseBandCapture()
+{
+    bandAnalyzerFifo.release();
+    bandCaptureBuffer = BlockType();
+}
+
+void SimpleMBCompAudioProcessor::captureBands(int numSamples)
+{
+    numSamples = juce::jmin(numSamples, bandCaptureBuffer.getNumSamples());
+    
+    for( size_t i = 0; i < filterBuffers.size(); ++i )
+    {
+        const auto& band = filterBuffers[i];
+        const auto numChannels = band.getNumChannels();
+        auto* dest = bandCaptureBuffer.getWritePointer(static_cast<int>(i));
+        
+        if( numChannels == 0 )
+        {
+            juce::FloatVectorOperations::clear(dest, numSamples);
+            continue;
+        }
+        
+        juce::FloatVectorOperations::copy(dest, band.getReadPointer(0), numSamples);
+        for( int ch = 1; ch < numChannels; ++ch )
+            juce::FloatVectorOperations::add(dest, band.getReadPointer(ch), numSamples);
+        juce::FloatVectorOperations::multiply(dest, 1.f / float(numChannels), numSamples);
+    }
+    
+    // refers to bandCaptureBuffer's channels, so only the sample count differs and nothing is allocated
+    BlockType block(bandCaptureBuffer.getArrayOfWritePointers(), bandCaptureBuffer.getNumChannels(), numSamples);
+    bandAnalyzerFifo.update(block);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -237,12 +302,10 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     juce::ignoreUnused (layouts);
     return true;
 #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any discrete or surround layout works, mono and stereo stay the first ones a host is offered.
+    // Every channel costs a SIMD lane, up to MaxChannels of them
+    const auto& output = layouts.getMainOutputChannelSet();
+    if (output.isDisabled() || output.size() > ChannelLanes::MaxChannels)
         return false;
     
     // This checks if the input layout matches the output layout
@@ -258,25 +321,70 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 
 /*!
  @brief Updates the state of the SimpleMBCompAudioProcessor.
- This method updates the settings of the compressors, the cutoff frequencies of the crossover filters and the input / output gain decibels.
+ This method reads every parameter once, blends in the snapshot morph while it's engaged, and updates the settings of the compressors, the target frequencies of the crossovers and the input / output gain decibels from the result.
+ @param numSamples The length of the block, the morph ramps advance by it.
  */
-void SimpleMBCompAudioProcessor::updateState()
+void SimpleMBCompAudioProcessor::updateState(int numSamples)
 {
-    // Important! auto& because we need to reference and call THE OBJECT ITSELF NOT A COPY
-    for ( auto& compressor : compressors )
-        compressor.updateCompressorSettings();
+    using namespace Params;
     
-    auto lowMidCutoffFreq = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoffFreq);
-    HP1.setCutoffFrequency(lowMidCutoffFreq);
+    readValues(apvts, blockValues);
+    snapshots.process(numSamples, blockValues);
     
-    auto midHighCutoffFreq = midHighCrossover->get();
-    AP2.setCutoffFrequency(midHighCutoffFreq);
-    LP2.setCutoffFrequency(midHighCutoffFreq);
-    HP2.setCutoffFrequency(midHighCutoffFreq);
+    for( size_t band = 0; band < NumBands; ++band )
+    {
+        auto value = [this, band](BandParam param) { return blockValues[forBand(param, band)]; };
+        
+        CompressorBand::Settings settings;
+        settings.attack = value(BandParam::Attack);
+        settings.release = value(BandParam::Release);
+        settings.threshold = value(BandParam::Threshold);
+        settings.ratio = ratioAt(value(BandParam::Ratio));
+        settings.bypassed = value(BandParam::Bypassed) >= 0.5f;
+        settings.mute = value(BandParam::Mute) >= 0.5f;
+        settings.solo = value(BandParam::Solo) >= 0.5f;
+        
+        // Important! auto& because we need to reference and call THE OBJECT ITSELF NOT A COPY
+        auto& compressor = compressors[band];
+        compressor.updateCompressorSettings(settings);
+    }
     
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
+    // only the soloed bands reach the output while any band is soloed, otherwise every band that isn't muted
+    const auto anySoloed = std::any_of(compressors.begin(), compressors.end(), [](const auto& comp) { return comp.getSettings().solo; });
+    for( size_t band = 0; band < NumBands; ++band )
+    {
+        const auto& settings = compressors[band].getSettings();
+        bandLevels[band].setTargetValue((anySoloed ? settings.solo : ! settings.mute) ? 1.f : 0.f);
+    }
+    
+    channelLink = static_cast<ChannelLink>(juce::jlimit(0, 2, juce::roundToInt(blockValues[Channel_Link])));
+    
+    lowMidCutoff.setTargetValue(blockValues[Low_Mid_Crossover_Freq]);
+    midHighCutoff.setTargetValue(blockValues[Mid_High_Crossover_Freq]);
+    
+    inputGain.setGainDecibels(blockValues[Gain_In]);
+    outputGain.setGainDecibels(blockValues[Gain_Out]);
+}
+
+void SimpleMBCompAudioProcessor::setCrossoverFrequencies(float lowMid, float midHigh)
+{
+    crossover.setCutoffFrequencies(lowMid, midHigh);
+}
+
+void SimpleMBCompAudioProcessor::storeSnapshot(size_t slot)
+{
+    Params::Values values;
+    Params::readValues(apvts, values);
+    snapshots.store(slot, values);
+}
+
+void SimpleMBCompAudioProcessor::applySnapshotMorph()
+{
+    Params::Values live, values;
+    Params::readValues(apvts, live);
+    snapshots.getMorphedValues(live, values);
+    Params::writeValues(apvts, values);
+    snapshots.setEngaged(false);
 }
 
 /**
@@ -286,32 +394,41 @@ void SimpleMBCompAudioProcessor::updateState()
  The audio data for each band is stored in different audio buffers. The process
  involves passing the audio input through a series of filters to separate the different bands.
  Everything that gets done here is mutating current state. Its important to note that this is impacting the following variables:
- LP1 AP2 HP1 LP2 HP2 and filterBuffers
- @param inputBuffer The audio input buffer that is being processed.
+ the crossover's filter state and filterBuffers
+ @param inputBuffer The audio input buffer that is being processed, at most as long as the filterBuffers.
+ @return Views of the first inputBuffer.getNumSamples() samples of the filterBuffers, low to high.
  */
-void SimpleMBCompAudioProcessor::splitBands(juce::AudioBuffer<float>& inputBuffer)
+std::array<SimpleMBCompAudioProcessor::BlockType, SimpleMBCompAudioProcessor::NumBands> SimpleMBCompAudioProcessor::splitBands(juce::AudioBuffer<float>& inputBuffer)
 {
+    const auto numChannels = juce::jmin(inputBuffer.getNumChannels(), filterBuffers.front().getNumChannels());
+    const auto numSamples = inputBuffer.getNumSamples();
+    jassert(numSamples <= filterBuffers.front().getNumSamples());
     
-    for( auto& fb : filterBuffers )
-        fb = inputBuffer;
-    
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
-    
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+    // they refer to the filterBuffers prepareToPlay allocated, nothing is allocated here
+    std::array<BlockType, NumBands> bands
+    {
+        BlockType(filterBuffers[0].getArrayOfWritePointers(), numChannels, numSamples),
+        BlockType(filterBuffers[1].getArrayOfWritePointers(), numChannels, numSamples),
+        BlockType(filterBuffers[2].getArrayOfWritePointers(), numChannels, numSamples)
+    };
     
-    // Band Splitting ---
-    LP1.process(fb0Ctx);
-    AP2.process(fb0Ctx);
+    if( ! lowMidCutoff.isSmoothing() && ! midHighCutoff.isSmoothing() )
+    {
+        setCrossoverFrequencies(lowMidCutoff.getTargetValue(), midHighCutoff.getTargetValue());
+        crossover.process(inputBuffer, bands, 0, numSamples);
+        return bands;
+    }
     
-    HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1];
+    // the filters are TPT structures, which stay stable while their cutoff moves, so retuning them every few
+    // samples is safe and keeps the sweep free of steps
+    for( int start = 0; start < numSamples; start += crossoverUpdateInterval )
+    {
+        const auto length = juce::jmin(numSamples - start, crossoverUpdateInterval);
+        setCrossoverFrequencies(lowMidCutoff.skip(length), midHighCutoff.skip(length));
+        crossover.process(inputBuffer, bands, start, length);
+    }
     
-    LP2.process(fb1Ctx);
-    HP2.process(fb2Ctx);
+    return bands;
 }
 
 
@@ -322,14 +439,13 @@ void SimpleMBCompAudioProcessor::splitBands(juce::AudioBuffer<float>& inputBuffe
  Clears any output channel that did not contain input data.
  Calls updateState to update the processor's state.
  If the condition is true, processes the input audio and applies gain to the audio buffer.
- Updates the left and right channel FIFO.
  Calls splitBands to split the audio buffer into three bands.
  Compresses each band by calling the process method of the compressors object.
  Clears the buffer.
- Adds or "sums" / "mixes" the 3 bands into the output buffer
- If any of the bands are soloed, adds the soloed band to the buffer.
- If none of the bands are soloed, adds the non-muted bands to the buffer.
+ Adds or "sums" / "mixes" the 3 bands into the output buffer, each at its level in bandLevels: the soloed bands
+ if any band is soloed, otherwise the non-muted bands. The levels ramp, so neither switch clicks.
  Calls applyGain to apply gain to the buffer.
+ Along the way the block is captured for the analyzer at whichever AnalyzerTap is selected.
  @param buffer The audio buffer to be processed.
  @param midiMessages The midi messages to be processed.
  */
@@ -348,7 +464,8 @@ void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    updateState();
+    updateState(buffer.getNumSamples());
+    parameterVersion.update();
     
     if( /* DISABLES CODE */ (false) )
     {
@@ -361,67 +478,124 @@ void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         gain.process(ctx);
     }
     
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    // read the tap once so a GUI change can't make us capture twice in one block.
+    // with no analyzer attached nothing is captured at all
+    const auto tap = analyzerConsumerActive.load() ? analyzerTap.load(std::memory_order_relaxed) : AnalyzerTap::None;
+    
+    captureIfTapped(tap, AnalyzerTap::PreInput, buffer);
     
     applyGain(buffer, inputGain);
-    splitBands(buffer);
+    captureIfTapped(tap, AnalyzerTap::PostInputGain, buffer);
+    
+    // the band buffers are sized once in prepareToPlay, a host may still send a longer block, so the bands are
+    // split, compressed and summed in chunks that fit them
+    const auto chunkSize = filterBuffers.front().getNumSamples();
+    jassert(chunkSize > 0);
+    
+    // every chunk adds to the band meters, publishMeters() reads them for the whole block
+    for( auto& compressor : compressors )
+        compressor.resetMeters();
+    
+    for( int start = 0; chunkSize > 0 && start < buffer.getNumSamples(); start += chunkSize )
+    {
+        // refers to buffer's channels, nothing is allocated
+        BlockType chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, juce::jmin(chunkSize, buffer.getNumSamples() - start));
+        processBands(chunk, tap);
+    }
+    
+    applyGain(buffer, outputGain);
+    captureIfTapped(tap, AnalyzerTap::Output, buffer);
+    
+    publishMeters(buffer);
+}
+
+/*!
+ @brief Splits the chunk into the bands, compresses them and sums them back into the chunk.
+ @param chunk At most as long as the filterBuffers.
+ @param tap The analyzer tap of this block.
+ */
+void SimpleMBCompAudioProcessor::processBands(BlockType& chunk, AnalyzerTap tap)
+{
+    auto bands = splitBands(chunk);
     // --------------
     
-    for( size_t i = 0; i < filterBuffers.size(); ++i )
+    constexpr std::array<AnalyzerTap, 3> bandTaps { AnalyzerTap::LowBand, AnalyzerTap::MidBand, AnalyzerTap::HighBand };
+    for( size_t i = 0; i < bands.size(); ++i )
     {
-        compressors[i].process(filterBuffers[i]);
+        compressors[i].process(bands[i], channelGroups[static_cast<size_t>(channelLink)]);
+        captureIfTapped(tap, bandTaps[i], bands[i]);
     }
     
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
+    if( bandAnalyzerActive.load() )
+        captureBands(chunk.getNumSamples());
+    
+    auto numSamples = chunk.getNumSamples();
+    auto numChannels = juce::jmin(chunk.getNumChannels(), bands.front().getNumChannels());
     
-    buffer.clear();
+    chunk.clear();
     
-    // Adds one buffer to another
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
+    // Adds one buffer to another, fading from startGain to endGain
+    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source, float startGain, float endGain)
     {
         for(auto i = 0; i < nc; ++i )
         {
             
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
+            inputBuffer.addFromWithRamp(i, 0, source.getReadPointer(i), ns, startGain, endGain);
         }
     };
     
-    auto bandsAreSoloed = false;
-    for( auto& comp : compressors)
+    for( size_t i = 0; i < bands.size(); ++i )
     {
-        if( comp.solo->get() )
-        {
-            bandsAreSoloed = true;
-            break;
-        }
+        auto& level = bandLevels[i];
+        
+        // a band that is fully out costs nothing
+        if( ! level.isSmoothing() && level.getTargetValue() <= 0.f )
+            continue;
+        
+        const auto startGain = level.getCurrentValue();
+        addFilterBand(chunk, bands[i], startGain, level.skip(numSamples));
     }
+}
+
+/*!
+ @brief Collects every meter for this block into one MeterSnapshot and publishes it to the GUI, and queues the
+ block's gain reduction ranges for the history lane.
+ @param output The block as it leaves the plugin.
+ */
+void SimpleMBCompAudioProcessor::publishMeters(const juce::AudioBuffer<float>& output)
+{
+    loudnessMeter.process(output);
     
-    if( bandsAreSoloed )
+    Meters meters;
+    for( size_t i = 0; i < compressors.size(); ++i )
+        meters.bands[i] = compressors[i].getMeters();
+    
+    auto rms = 0.f;
+    auto peak = 0.f;
+    for( int ch = 0; ch < output.getNumChannels(); ++ch )
     {
-        for( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if( comp.solo->get() )
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
+        rms += output.getRMSLevel(ch, 0, output.getNumSamples());
+        peak = juce::jmax(peak, output.getMagnitude(ch, 0, output.getNumSamples()));
     }
-    else
+    
+    if( output.getNumChannels() > 0 )
+        rms /= static_cast<float>(output.getNumChannels());
+    
+    meters.outputRmsDb = juce::Decibels::gainToDecibels(rms, NEGATIVE_INFINITY);
+    meters.outputPeakDb = juce::Decibels::gainToDecibels(peak, NEGATIVE_INFINITY);
+    meters.momentaryLufs = loudnessMeter.getMomentaryLoudness(NEGATIVE_INFINITY);
+    
+    meterSnapshot.write(meters);
+    
+    GainReductionHistory::Block grBlock;
+    grBlock.numSamples = output.getNumSamples();
+    for( size_t i = 0; i < NumBands; ++i )
     {
-        for( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if( !comp.mute->get() )
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
+        grBlock.minDb[i] = meters.bands[i].gainReductionMinDb;
+        grBlock.maxDb[i] = meters.bands[i].gainReductionMaxDb;
     }
     
-    applyGain(buffer, outputGain);
+    gainReductionHistory.push(grBlock);
 }
 
 //==============================================================================
@@ -452,8 +626,8 @@ void SimpleMBCompAudioProcessor::getStateInformation (juce::MemoryBlock& destDat
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
     
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    // every bit of state is a parameter, so the values alone are the state
+    BinaryState::write(apvts, destData);
 }
 
 void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -461,7 +635,13 @@ void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int size
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
     
-    //
+    if( BinaryState::isBinaryState(data, sizeInBytes) )
+    {
+        BinaryState::read(apvts, data, sizeInBytes);
+        return;
+    }
+    
+    // sessions saved before the binary format stored the whole ValueTree
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if(tree.isValid())
     {
@@ -475,140 +655,15 @@ void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int size
  by adding various audio parameters such as gain, threshold, attack/release, ratio,
  solo, mute, bypass, and crossover frequencies. The parameters are added using the
  AudioParameterFloat, AudioParameterChoice, and AudioParameterBool classes
- provided by the JUCE library. The parameters are populated using the GetParams
- function and the Params::Names enumeration.
+ provided by the JUCE library. The parameters, their IDs, ranges and defaults come from
+ the compile time Params::Table, in Params::Names order.
  @return A juce::AudioProcessorValueTreeState::ParameterLayout object representing the
  parameter layout for the Simple MBComp audio processor.
  */
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::createParameterLayout()
 {
-    APVTS::ParameterLayout layout;
-    
-    using namespace juce;
-    using namespace Params;
-    const auto& params = GetParams();
-    
-    // Gain
-    auto gainRange = NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.5f);
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Gain_In), 1},
-                                                     params.at(Names::Gain_In),
-                                                     gainRange,
-                                                     0));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Gain_Out), 1},
-                                                     params.at(Names::Gain_Out),
-                                                     gainRange,
-                                                     0));
-    // Thresh
-    auto thresholdRange = NormalisableRange<float>(MIN_THRESHOLD, MAX_DECIBALS, 1, 1);
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Threshold_Low_Band), 1},
-                                                     params.at(Names::Threshold_Low_Band),
-                                                     thresholdRange,
-                                                     0));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Threshold_Mid_Band), 1},
-                                                     params.at(Names::Threshold_Mid_Band),
-                                                     thresholdRange,
-                                                     0));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Threshold_High_Band), 1},
-                                                     params.at(Names::Threshold_High_Band),
-                                                     thresholdRange,
-                                                     0));
-    
-    // Attack / Release
-    auto attackReleaseRange = NormalisableRange<float>(5, 500, 1, 1);
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Attack_Low_Band), 1},
-                                                     params.at(Names::Attack_Low_Band),
-                                                     attackReleaseRange,
-                                                     50));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Attack_Mid_Band), 1},
-                                                     params.at(Names::Attack_Mid_Band),
-                                                     attackReleaseRange,
-                                                     50));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Attack_High_Band), 1},
-                                                     params.at(Names::Attack_High_Band),
-                                                     attackReleaseRange,
-                                                     50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Release_Low_Band), 1},
-                                                     params.at(Names::Release_Low_Band),
-                                                     attackReleaseRange,
-                                                     250));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Release_Mid_Band), 1},
-                                                     params.at(Names::Release_Mid_Band),
-                                                     attackReleaseRange,
-                                                     250));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Release_High_Band), 1},
-                                                     params.at(Names::Release_High_Band),
-                                                     attackReleaseRange,
-                                                     250));
-    
-    // Ratio
-    auto choices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 10, 15, 20, 50, 100 };
-    juce::StringArray sa;
-    
-    for( auto choice : choices )
-    {
-        sa.add(juce::String(choice, 1));
-    }
-    
-    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Ratio_Low_Band), 1},
-                                                      params.at(Names::Ratio_Low_Band),
-                                                      sa,
-                                                      3));
-    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Ratio_Mid_Band), 1},
-                                                      params.at(Names::Ratio_Mid_Band),
-                                                      sa,
-                                                      3));
-    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Ratio_High_Band), 1},
-                                                      params.at(Names::Ratio_High_Band),
-                                                      sa,
-                                                      3));
-    
-    // Solo
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Solo_Low_Band), 1},
-                                                    params.at(Names::Solo_Low_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Solo_Mid_Band), 1},
-                                                    params.at(Names::Solo_Mid_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Solo_High_Band), 1},
-                                                    params.at(Names::Solo_High_Band),
-                                                    false));
-    
-    // Mute
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Mute_Low_Band), 1},
-                                                    params.at(Names::Mute_Low_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Mute_Mid_Band), 1},
-                                                    params.at(Names::Mute_Mid_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Mute_High_Band), 1},
-                                                    params.at(Names::Mute_High_Band),
-                                                    false));
-    
-    // Bypass
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Bypassed_Low_Band), 1},
-                                                    params.at(Names::Bypassed_Low_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Bypassed_Mid_Band), 1},
-                                                    params.at(Names::Bypassed_Mid_Band),
-                                                    false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Bypassed_High_Band), 1},
-                                                    params.at(Names::Bypassed_High_Band),
-                                                    false));
-    
-    // Crossovers
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Low_Mid_Crossover_Freq), 1},
-                                                     params.at(Names::Low_Mid_Crossover_Freq),
-                                                     NormalisableRange<float>(20, 999, 1, 1),
-                                                     400));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Mid_High_Crossover_Freq), 1},
-                                                     params.at(Names::Mid_High_Crossover_Freq),
-                                                     NormalisableRange<float>(1000, 20000, 1,1),
-                                                     2000));
-    
-    return layout;
+    // the table lives in Params, so anything that needs the parameters without a whole processor can build them too
+    return Params::createParameterLayout();
 }
 
 /*!
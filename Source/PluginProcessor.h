@@ -10,20 +10,44 @@
 
 #include <JuceHeader.h>
 #include "DSP/CompressorBand.h"
-#include "DSP/SingleChannelSampleFifo.h"
+#include "DSP/LoudnessMeter.h"
+#include "DSP/TripleBuffer.h"
+#include "DSP/GainReductionRing.h"
+#include "DSP/ParameterVersion.h"
+#include "DSP/SnapshotMorph.h"
+#include "DSP/Crossover.h"
+#include "DSP/ChannelLinking.h"
+#include "DSP/MultiChannelSampleFifo.h"
 #include <array>
 
+/*!
+ @brief The points in processBlock where the analyzer can listen.
+ Only the selected tap feeds the analyzerFifo, every other tap is a single comparison on the audio thread.
+ */
+enum class AnalyzerTap
+{
+    PreInput,       //!< the block as the host hands it to us
+    PostInputGain,  //!< after the input trim
+    LowBand,        //!< the low band after its compressor
+    MidBand,        //!< the mid band after its compressor
+    HighBand,       //!< the high band after its compressor
+    Output,         //!< the summed bands after the output trim
+    None            //!< nothing is captured, used while no analyzer is attached
+};
+
 /*!
  @class SimpleMBCompAudioProcessor
  @brief The main audio processing class for the Simple Multiband Compressor plugin.
  This class is responsible for splitting the audio into 3 frequency bands using Linkwitz-Riley filters, applying
- separate compressors to each band, and then summing the bands together to produce a compressed signal. The
+ separate compressors to each band, and then summing the bands together to produce a compressed signal. Any
+ layout up to ChannelLanes::MaxChannels channels is processed in one instance, the filters and detectors run
+ every channel side by side in SIMD lanes. The
  parameters for the filters and compressors can be adjusted through the user interface created by the
  SimpleMBCompAudioProcessorEditor class. The AudioProcessorValueTreeState (APVTS) object is used to manage the
  plugin's parameters and their values.
  @see SimpleMBCompAudioProcessorEditor
  @see CompressorBand
- @see SingleChannelSampleFifo
+ @see MultiChannelSampleFifo
  @see juce::AudioProcessor
  @see juce::AudioProcessorValueTreeState
  */
@@ -75,29 +99,106 @@ public:
     APVTS apvts { *this, nullptr, "Parameters", createParameterLayout() };
     
     using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
+    /*! every channel is captured in one pass, the analyzer derives L/R/mid/side/sum from it */
+    MultiChannelSampleFifo<BlockType> analyzerFifo;
+    
+    void setAnalyzerTap(AnalyzerTap tap) { analyzerTap.store(tap); }
+    AnalyzerTap getAnalyzerTap() const { return analyzerTap.load(); }
+    
+    /*!
+     @brief Registers an analyzer that reads from the analyzerFifo. Message thread only.
+     The capture buffers are allocated here (or in prepareToPlay), never on the audio thread, and processBlock
+     only captures while at least one analyzer is attached.
+     */
+    void attachAnalyzer();
+    /*!
+     @brief Unregisters an analyzer. When the last one detaches capturing stops immediately and the buffers are
+     freed the next time the audio thread is stopped.
+     */
+    void detachAnalyzer();
     
-    std::array<CompressorBand, 3> compressors;
+    /*!
+     every band's compressed output, summed to mono, as channel 0 (low), 1 (mid) and 2 (high). Only captured
+     while a band analyzer is attached, with the same rules as attachAnalyzer() and detachAnalyzer().
+     */
+    MultiChannelSampleFifo<BlockType> bandAnalyzerFifo;
+    void attachBandAnalyzer();
+    void detachBandAnalyzer();
+    
+    static constexpr size_t NumBands = 3;
+    using Meters = MeterSnapshot<NumBands>;
+    
+    /*!
+     @brief The meters of the most recent audio block, read as a whole. GUI thread only, one reader at a time.
+     */
+    const Meters& getMeters() { return meterSnapshot.readLatest(); }
+    
+    using GainReductionHistory = GainReductionRing<NumBands>;
+    
+    /*!
+     @brief Every block's gain reduction range, for the history lane. GUI thread only, one reader at a time.
+     */
+    GainReductionHistory& getGainReductionHistory() { return gainReductionHistory; }
+    
+    /*!
+     @brief A number that changes whenever any parameter changed, see ParameterVersion. processBlock() keeps it
+     current, and this checks the parameters once more so a GUI still notices changes while the host isn't
+     processing. Poll it once per frame.
+     */
+    uint32_t pollParameterVersion()
+    {
+        parameterVersion.update();
+        return parameterVersion.get();
+    }
+    
+    static constexpr size_t NumSnapshots = 2;
+    using Snapshots = SnapshotMorph<NumSnapshots>;
+    
+    /*!
+     @brief The A/B snapshots. Switching and morphing between them happens on the audio thread, the parameters
+     keep their values until applySnapshotMorph(). Message thread only.
+     */
+    Snapshots& getSnapshots() { return snapshots; }
+    /*! @brief Stores every parameter's current value in a snapshot slot. Message thread only. */
+    void storeSnapshot(size_t slot);
+    /*!
+     @brief Writes the morphed snapshots into the parameters, so the host sees them, and disengages the morph.
+     The audio doesn't change, the morph ramps out towards the values it just wrote. Message thread only.
+     */
+    void applySnapshotMorph();
+    
+    std::array<CompressorBand, NumBands> compressors;
     CompressorBand& lowBandComp = compressors[0];
     CompressorBand& midBandComp = compressors[1];
     CompressorBand& highBandComp = compressors[2];
     
 private:
     juce::dsp::Compressor<float> compressor;
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    //     fc0  fc1
-    Filter LP1, AP2,
-    HP1, LP2,
-    HP2;
+    Crossover crossover;
+    
+    /*! the detector groups of the prepared layout for every ChannelLink, made in prepareToPlay */
+    std::array<ChannelGroups, 3> channelGroups;
+    ChannelLink channelLink { ChannelLink::Off };
     
-    juce::AudioParameterFloat* lowMidCrossover { nullptr };
-    juce::AudioParameterFloat* midHighCrossover { nullptr };
+    /*!
+     the crossovers glide to new frequencies, and splitBands() retunes the filters every crossoverUpdateInterval
+     samples while they do, so neither an automated crossover nor a morph zippers
+     */
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> lowMidCutoff, midHighCutoff;
+    static constexpr int crossoverUpdateInterval = 32;
+    void setCrossoverFrequencies(float lowMid, float midHigh);
     
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
+    std::array<juce::AudioBuffer<float>, NumBands> filterBuffers;
+    /*!
+     every band's share of the sum, 0 while it's muted or another band is soloed. They ramp as long as the snapshot
+     morph does, so muting, soloing or morphing across either fades the band instead of cutting it
+     */
+    std::array<juce::SmoothedValue<float>, NumBands> bandLevels;
     juce::dsp::Gain<float> inputGain, outputGain;
-    juce::AudioParameterFloat* inputGainParam { nullptr };
-    juce::AudioParameterFloat* outputGainParam { nullptr };
+    
+    Snapshots snapshots;
+    /*! every parameter's value for the current block, as read from the parameters and blended with the snapshot morph */
+    Params::Values blockValues {};
     
     
     template<typename T, typename U>
@@ -107,8 +208,45 @@ private:
         auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
         gain.process(ctx);
     }
-    void updateState();
-    void splitBands(juce::AudioBuffer<float>& inputBuffer);
+    void updateState(int numSamples);
+    std::array<BlockType, NumBands> splitBands(juce::AudioBuffer<float>& inputBuffer);
+    void processBands(BlockType& chunk, AnalyzerTap tap);
+    
+    std::atomic<AnalyzerTap> analyzerTap { AnalyzerTap::PreInput };
+    
+    /*! set once the analyzerFifo is prepared and somebody reads from it, checked once per block */
+    std::atomic<bool> analyzerConsumerActive { false };
+    /*! guards the fields below against prepareToPlay and attach/detach racing, never taken on the audio thread */
+    juce::CriticalSection analyzerLock;
+    int numAnalyzerConsumers { 0 };
+    int analyzerNumChannels { 0 };
+    int analyzerBlockSize { 0 };
+    
+    std::atomic<bool> bandAnalyzerActive { false };
+    int numBandAnalyzerConsumers { 0 };
+    /*! one channel per band, only allocated while a band analyzer is attached, like the bandAnalyzerFifo */
+    BlockType bandCaptureBuffer;
+    /*! @brief Allocates the bandAnalyzerFifo and the bandCaptureBuffer, or frees both. Hold the analyzerLock, with capturing off. */
+    void prepareBandCapture();
+    void releaseBandCapture();
+    /*! @brief Mixes each band down to one channel of bandCaptureBuffer and feeds the bandAnalyzerFifo. */
+    void captureBands(int numSamples);
+    
+    /*! @brief Feeds the analyzerFifo only when this is the tap the analyzer asked for. */
+    void captureIfTapped(AnalyzerTap selected, AnalyzerTap here, const BlockType& block)
+    {
+        if( selected == here )
+            analyzerFifo.update(block);
+    }
+    
+    LoudnessMeter loudnessMeter;
+    /*! published once at the end of every processBlock */
+    TripleBuffer<Meters> meterSnapshot;
+    /*! fed alongside meterSnapshot, but keeps every block */
+    GainReductionHistory gainReductionHistory;
+    
+    ParameterVersion parameterVersion;
+    void publishMeters(const juce::AudioBuffer<float>& output);
     
     juce::dsp::Oscillator<float> osc;
     juce::dsp::Gain<float> gain;